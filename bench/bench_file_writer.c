@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "graph.h"
+#include "partition.h"
+#include "file_reader.h"
+#include "file_writer.h"
+#include "part_file.h"
+
+// benchmark zapisu podzialu - pokazuje ze czas rosnie liniowo z rozmiarem grafu
+// dla porownania mierzy tez stary sposob sprawdzania przynaleznosci (przeglad listy czesci)
+
+#define BENCH_PARTS 8
+#define BENCH_OUTPUT "/tmp/bench_file_writer.csrrg"
+#define BENCH_PART_OUTPUT "/tmp/bench_file_writer.part"
+
+// najwiekszy graf, dla ktorego liczymy jeszcze wariant liniowy (jest kwadratowy)
+#define BENCH_LINEAR_LIMIT 160000
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// siatka side x side podzielona na BENCH_PARTS pasow kolumn
+static void build_grid(Graph *graph, ParsedData *data, Partition_data *partition_data, int side)
+{
+    int n = side * side;
+    inicialize_graph(graph, n);
+    for (int r = 0; r < side; r++)
+    {
+        for (int c = 0; c < side; c++)
+        {
+            int v = r * side + c;
+            if (c + 1 < side)
+            {
+                add_neighbor(&graph->nodes[v], v + 1);
+                add_neighbor(&graph->nodes[v + 1], v);
+            }
+            if (r + 1 < side)
+            {
+                add_neighbor(&graph->nodes[v], v + side);
+                add_neighbor(&graph->nodes[v + side], v);
+            }
+        }
+    }
+    count_edges(graph);
+
+    assing_parts(graph, BENCH_PARTS);
+    for (int v = 0; v < n; v++)
+    {
+        set_part_id(graph, v, (v % side) * BENCH_PARTS / side);
+    }
+    initialize_partition_data(partition_data, BENCH_PARTS);
+    rebuild_partition_data(partition_data, graph);
+
+    // pierwsze trzy linie formatu csrrg: szerokosc, kolumny i wskazniki wierszy
+    data->line1 = malloc(sizeof(int));
+    data->line2 = malloc(n * sizeof(int));
+    data->line3 = malloc((side + 1) * sizeof(int));
+    if (!data->line1 || !data->line2 || !data->line3)
+    {
+        perror("Blad alokacji pamieci");
+        exit(EXIT_FAILURE);
+    }
+    *data->line1 = side;
+    data->line2_count = n;
+    data->line3_count = side + 1;
+    for (int v = 0; v < n; v++)
+    {
+        data->line2[v] = v % side;
+    }
+    for (int r = 0; r <= side; r++)
+    {
+        data->line3[r] = r * side;
+    }
+}
+
+// wynik wariantu liniowego, zeby kompilator nie usunal petli
+static volatile long linear_sink;
+
+// dawny sposob: przynaleznosc sasiada sprawdzana przegladem listy czesci
+static long linear_membership_pass(const Graph *graph, const Partition_data *partition_data)
+{
+    long found = 0;
+    for (int p = 0; p < partition_data->parts_count; p++)
+    {
+        const Part *part = &partition_data->parts[p];
+        for (int i = 0; i < part->part_vertex_count; i++)
+        {
+            const Node *node = &graph->nodes[part->part_vertexes[i]];
+            for (int j = 0; j < node->neighbor_count; j++)
+            {
+                for (int k = 0; k < part->part_vertex_count; k++)
+                {
+                    if (part->part_vertexes[k] == node->neighbors[j])
+                    {
+                        found++;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return found;
+}
+
+int main(void)
+{
+    int sides[] = {100, 200, 400, 800, 1000};
+    int count = sizeof(sides) / sizeof(sides[0]);
+
+    printf("%10s %12s %14s %14s %16s %14s\n", "vertices", "edges", "write_text[s]", "ns/edge", "linear scan[s]",
+           "write_part[s]");
+    for (int i = 0; i < count; i++)
+    {
+        Graph graph;
+        ParsedData data = {0};
+        Partition_data partition_data;
+        build_grid(&graph, &data, &partition_data, sides[i]);
+
+        double start = now_seconds();
+        write_text(BENCH_OUTPUT, &data, &partition_data, &graph, BENCH_PARTS);
+        double write_time = now_seconds() - start;
+
+        start = now_seconds();
+        write_part_file(BENCH_PART_OUTPUT, &graph);
+        double part_time = now_seconds() - start;
+
+        char linear[32] = "-";
+        if (graph.vertices <= BENCH_LINEAR_LIMIT)
+        {
+            start = now_seconds();
+            linear_sink = linear_membership_pass(&graph, &partition_data);
+            snprintf(linear, sizeof(linear), "%.3f", now_seconds() - start);
+        }
+
+        printf("%10d %12d %14.3f %14.1f %16s %14.4f\n", graph.vertices, graph.edges, write_time,
+               write_time * 1e9 / graph.edges, linear, part_time);
+
+        free(data.line1);
+        free(data.line2);
+        free(data.line3);
+        free_partition_data(&partition_data, BENCH_PARTS);
+        free_graph(&graph);
+    }
+
+    remove(BENCH_OUTPUT);
+    remove(BENCH_PART_OUTPUT);
+    return 0;
+}
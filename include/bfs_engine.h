@@ -0,0 +1,45 @@
+#ifndef BFS_ENGINE_H
+#define BFS_ENGINE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "graph.h"
+#include "traversal.h"
+#include "thread_pool.h"
+
+// graf ponizej tej liczby wierzcholkow jest sprawdzany szeregowo, synchronizacja puli by sie nie oplacila
+#define PARALLEL_BFS_MIN_VERTICES 32768
+
+// parametry przelaczania kierunku BFS (Beamer i in.)
+// top-down -> bottom-up gdy krawedzie frontu > krawedzie nieodwiedzonych / ALPHA
+// bottom-up -> top-down gdy front < liczba wierzcholkow / BETA
+#define BFS_ALPHA 14
+#define BFS_BETA 24
+
+// indeks czesci - wierzcholki posortowane wedlug czesci jednym sortowaniem przez zliczanie
+typedef struct Part_index
+{
+    int parts;        // liczba czesci
+    int *offsets;     // poczatek listy kazdej czesci w members (parts + 1 elementow)
+    int *members;     // wierzcholki posortowane wedlug czesci
+    int *local_index; // pozycja wierzcholka na liscie jego czesci
+} Part_index;
+
+// buduje indeks czesci w czasie O(V), wierzcholki bez przypisania sa pomijane
+void build_part_index(const Graph *graph, int parts, Part_index *index);
+
+// zwalnia indeks czesci
+void free_part_index(Part_index *index);
+
+// BFS zmieniajacy kierunek (top-down/bottom-up) z frontami w mapach bitowych
+// przechodzi czesc part_id od jej pierwszego wierzcholka, zwraca liczbe osiagnietych wierzcholkow
+int bfs_part_reachable(const Graph *graph, const Part_index *index, int part_id);
+
+// sprawdza spojnosc wszystkich czesci rownolegle na wspolnej puli watkow
+// jesli connected nie jest NULL, zapisuje w nim wynik dla kazdej czesci
+// zwraca 1 jesli wszystkie czesci sa spojne
+int check_all_parts_connected(const Graph *graph, int parts, int *connected);
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef BUCKET_QUEUE_H
+#define BUCKET_QUEUE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// pozycja kolejki - nieprzypisany wierzcholek we froncie jednej czesci
+// kluczem jest liczba jego sasiadow juz nalezacych do tej czesci
+typedef struct Bucket_entry
+{
+    int vertex;      // wierzcholek
+    int part;        // czesc, do ktorej frontu nalezy pozycja
+    int key;         // liczba sasiadow w czesci
+    int prev;        // poprzednia pozycja w kubelku (-1 = poczatek)
+    int next;        // nastepna pozycja w kubelku lub na liscie wolnych (-1 = koniec)
+    int vertex_next; // nastepna pozycja tego samego wierzcholka w innej czesci
+} Bucket_entry;
+
+// kubelkowe kolejki priorytetowe frontow wszystkich czesci
+// kazdy wierzcholek wystepuje we froncie czesci co najwyzej raz, zmiana klucza kosztuje O(1),
+// a pozycje jednego wierzcholka sa polaczone w liste, zeby po przypisaniu usunac je ze wszystkich frontow
+typedef struct Bucket_queue
+{
+    int parts;              // liczba czesci
+    Bucket_entry *entries;  // pula pozycji
+    int entry_count;        // liczba uzytych pozycji puli
+    int entry_capacity;     // pojemnosc puli
+    int free_entry;         // poczatek listy zwolnionych pozycji
+    int *vertex_first;      // pierwsza pozycja wierzcholka (-1 = nie ma go w zadnym froncie)
+    int **buckets;          // buckets[czesc][klucz] - pierwsza pozycja kubelka
+    int *bucket_capacity;   // liczba kubelkow czesci
+    int *max_key;           // gorne ograniczenie najwiekszego niepustego klucza czesci
+    int *sizes;             // liczba wierzcholkow we froncie czesci
+} Bucket_queue;
+
+// tworzy puste kolejki dla grafu o podanej liczbie wierzcholkow
+Bucket_queue *create_bucket_queue(int vertices, int parts);
+
+// zwalnia kolejki
+void free_bucket_queue(Bucket_queue *queue);
+
+// zwieksza klucz wierzcholka we froncie czesci, wierzcholka spoza frontu dodaje z kluczem 1
+void bucket_queue_increment(Bucket_queue *queue, int part, int vertex);
+
+// zdejmuje z frontu czesci wierzcholek o najwiekszym kluczu i usuwa go ze wszystkich frontow
+// zwraca -1 gdy front jest pusty
+int bucket_queue_pop(Bucket_queue *queue, int part);
+
+// usuwa wierzcholek ze wszystkich frontow (np. gdy zostal przypisany poza kolejka)
+void bucket_queue_remove(Bucket_queue *queue, int vertex);
+
+// liczba wierzcholkow we froncie czesci
+static inline int bucket_queue_size(const Bucket_queue *queue, int part)
+{
+    return queue->sizes[part];
+}
+
+#endif
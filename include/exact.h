@@ -0,0 +1,43 @@
+#ifndef EXACT_H
+#define EXACT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "graph.h"
+#include "partition.h"
+
+// najwiekszy graf dla rozwiazania dokladnego - podzbior wierzcholkow to jedno slowo 64-bitowe
+#define EXACT_MAX_VERTICES 64
+
+// podzial dokladny uruchamiany automatycznie tylko gdy wierzcholki * (czesci - 1) nie przekraczaja tej
+// wartosci - drzewo rosnie mniej wiecej jak k^V, a na siatkach wieksze przypadki wyczerpuja limit wezlow
+// (siatka 8 x 8 na 2 czesci konczy sie w 0.01 s, na 3 czesci juz nie)
+#define EXACT_AUTO_MAX_WORK 72
+
+// limit wezlow drzewa przeszukiwania, po jego przekroczeniu wynik nie jest dowodem optymalnosci
+#define EXACT_NODE_LIMIT 1000000L
+
+// wynik rozwiazania dokladnego
+typedef struct Exact_result
+{
+    int status; // 1 = znaleziono optimum, 0 = brak podzialu spelniajacego warunki lub przekroczony limit
+    int cut;    // liczba przecietych krawedzi optymalnego podzialu
+    long nodes; // liczba odwiedzonych wezlow drzewa
+} Exact_result;
+
+// dokladny podzial metoda podzialu i ograniczen dla grafow do EXACT_MAX_VERTICES wierzcholkow
+// minimalizuje ciecie przy czesciach spojnych i rozmiarach z [min_count, max_count] dla dokladnosci,
+// czesci sa zbiorami bitowymi, dolne ograniczenie to krawedzie do przypisanych sasiadow, ktorych
+// nie da sie uniknac, a czesci bez przypiec sa numerowane w kolejnosci pierwszego uzycia (bez symetrii)
+// przypiete wierzcholki zostaja w swoich czesciach; sluzy tez jako podzial najgrubszego poziomu
+// przy powodzeniu zapisuje podzial w grafie i listach czesci, przy porazce graf zostaje bez przypisan
+Exact_result exact_partition(Graph *graph, int parts, Partition_data *partition_data, float accuracy);
+
+// czy podzial dokladny warto uruchomic automatycznie (konczy sie w krotkim czasie)
+static inline int exact_partition_suitable(const Graph *graph, int parts)
+{
+    return graph->vertices <= EXACT_MAX_VERTICES && (long)graph->vertices * (parts - 1) <= EXACT_AUTO_MAX_WORK;
+}
+
+#endif
@@ -37,8 +37,14 @@ void read_binary(const char *filename);
 
 // wczytuje graf z pliku tekstowego do struktury Graph
 // korzysta ze struktury ParsedData do przechowania danych posrednich
+// z drugiej i trzeciej linii odczytuje tez wspolrzedne wierzcholkow (coord_rows, coord_cols)
 void load_graph(const char *filename, Graph *graph, ParsedData *data);
 
+// wczytuje plik przypiec: w kazdej linii numer wierzcholka i numer czesci
+// (oddzielone spacja, srednikiem lub przecinkiem, linie od # sa pomijane)
+// wypelnia graph->pinned, wymaga ustawionej liczby czesci, zwraca liczbe przypietych wierzcholkow
+int load_pin_file(const char *filename, Graph *graph);
+
 // dodaje sasiada do listy sasiadow wierzcholka
 // jesli brakuje miejsca to zwieksza bufor
 void add_neighbor(Node *node, int neighbor);
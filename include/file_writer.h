@@ -4,6 +4,7 @@
 #include "file_reader.h"
 #include "partition.h"
 #include "graph.h"
+#include "subgraph.h"
 #include <stdint.h> 
 
 // maksymalna liczba sasiadow jaka moze miec wierzcholek
@@ -21,16 +22,17 @@ void write_text(const char *filename, const ParsedData *data, const Partition_da
 // podobne parametry co write_text ale zapisuje w formacie binarnym z vbyte
 void write_binary(const char *filename, const ParsedData *data, const Partition_data *partition_data, const Graph *graph, int parts);
 
+// zapisuje podgrafy czesci z numeracja lokalna (format "local")
+// naglowek: liczba czesci i separator, potem dla kazdej czesci: liczba wierzcholkow, liczba pozycji
+// sasiedztwa, numery globalne jako roznice, stopnie, lokalni sasiedzi i separator - wszystko w vbyte
+void write_local_binary(const char *filename, const Subgraph_set *set);
+
 // koduje liczbe w formacie vbyte (zmienna liczba bajtow)
 // im mniejsza liczba tym mniej bajtow potrzeba
 void encode_vbyte(FILE *file, int value);
 
 // znajduje wszystkich sasiadow wierzcholka ktorzy sa w tej samej czesci grafu
 // zwraca przez parametry neighbors i count
-void get_partition_neighbors(const Graph *graph, const Partition_data *partition_data, int part_id, int vertex, int *neighbors, int *count);
-
-// sprawdza czy dany wierzcholek nalezy do danej czesci grafu
-// zwraca 1 jesli tak, 0 jesli nie
-int is_in_partition(const Partition_data *partition_data, int part_id, int vertex);
+void get_partition_neighbors(const Graph *graph, int part_id, int vertex, int *neighbors, int *count);
 
 #endif
\ No newline at end of file
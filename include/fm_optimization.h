@@ -9,6 +9,9 @@
 #include "graph.h"
 #include "partition.h"
 #include "region_growing.h"
+#include "gain_kernel.h"
+#include "sell_graph.h"
+#include "quotient_graph.h"
 #include <unistd.h>
 
 // deklaracje zapowiadajace, zeby uniknac cyklicznych zaleznosci
@@ -50,11 +53,15 @@ typedef struct
     int current_cut;           // biezaca liczba krawedzi przekrojowych
     int best_cut;              // najlepsza znaleziona liczba krawedzi przecinajacych
     int *best_partition;       // najlepszy znaleziony podzial
+    int *internal_degrees;     // stopnie wewnetrzne z jadra SELL (NULL bez ukladu SELL)
 } FM_Context;
 
 // glowna funkcja optymalizacji algorytmem Fiduccia-Mattheysa
 void cut_edges_optimization(Graph *graph, Partition_data *partition_data, int max_iterations);
 
+// wylacza (1) lub wlacza (0) wypisywanie statystyk FM w biezacym watku
+void set_fm_quiet(int quiet);
+
 // tworzy i inicjalizuje strukture kontekstowa dla algorytmu FM
 FM_Context *initialize_fm_context(Graph *graph, Partition_data *partition_data, int max_iterations);
 
@@ -91,6 +98,9 @@ void save_best_solution(FM_Context *context);
 // przywraca najlepsze znalezione rozwiazanie
 void restore_best_solution(FM_Context *context);
 
+// sprawdza czy cala partycja jest spojna
+int is_partition_connected(Graph *graph, int part_id);
+
 // sprawdza czy usuniecie wierzcholka z partycji nie naruszy jej spojnosci
 int will_remain_connected_if_removed(Graph *graph, int vertex);
 
@@ -100,6 +110,9 @@ int is_move_valid_with_integrity(FM_Context *context, int vertex, int target_par
 // wykonuje ruch z zachowaniem spojnosci partycji
 int apply_move_safely(FM_Context *context, int vertex, int target_part);
 
+// liczy krawedzie przecinajace granice partycji
+int count_cut_edges(Graph *graph);
+
 //
 
 #endif // FM_OPTIMIZATION_H
@@ -0,0 +1,15 @@
+#ifndef GAIN_KERNEL_H
+#define GAIN_KERNEL_H
+
+#include "graph.h"
+
+// liczy zysk z przeniesienia wierzcholka z current_part do target_part
+// dla kazdego sasiada w target_part zysk rosnie o 1, dla sasiada w current_part maleje o 1
+// przy kompilacji z AVX-512 lub AVX2 przypisania sasiadow sa pobierane instrukcja gather
+// po kilkanascie naraz, w przeciwnym razie uzywana jest petla skalarna
+int gain_kernel(const Graph *graph, const int *neighbors, int count, int current_part, int target_part);
+
+// skalarna wersja kernela, uzywana dla koncowek tablic i jako wzorzec w testach
+int gain_kernel_scalar(const Graph *graph, const int *neighbors, int count, int current_part, int target_part);
+
+#endif
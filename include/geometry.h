@@ -0,0 +1,31 @@
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "graph.h"
+#include "partition.h"
+
+// sposob geometrycznego podzialu wstepnego
+typedef enum Geometric_mode
+{
+    GEOMETRIC_HILBERT, // wierzcholki w kolejnosci krzywej Hilberta ciete na rowne odcinki
+    GEOMETRIC_RCB      // rekurencyjna bisekcja wspolrzednych wzdluz dluzszego boku
+} Geometric_mode;
+
+// pozycja punktu (wiersz, kolumna) na krzywej Hilberta wypelniajacej kwadrat 2^order x 2^order
+uint64_t hilbert_index(int order, uint32_t row, uint32_t col);
+
+// zwraca wierzcholki posortowane wzdluz krzywej Hilberta (O(V log V))
+// NULL gdy graf nie ma wspolrzednych
+int *hilbert_order(const Graph *graph);
+
+// podzial wstepny ze wspolrzednych wierzcholkow, bez przechodzenia grafu
+// czesci maja rowne rozmiary, przypiete wierzcholki trafiaja do swoich czesci,
+// a odcinki niespojne w grafie naprawia to samo zakonczenie co w region growing
+// zwraca 1 gdy podzial miesci sie w dokladnosci, 0 w przeciwnym razie
+int geometric_partition(Graph *graph, int parts, Partition_data *partition_data, float accuracy,
+                        Geometric_mode mode);
+
+#endif
@@ -6,6 +6,10 @@
 #include <stdint.h>
 #include "partition.h"
 
+struct Sell_graph;
+struct Part_neighbors;
+struct Quotient_graph;
+
 // struktura reprezentujaca wierzcholek grafu
 // zawiera informacje o sasiadach i przydzielonej partycji
 typedef struct Node
@@ -13,7 +17,6 @@ typedef struct Node
     int vertex;            // indeks wierzcholka
     int *neighbors;        // tablica sasiadow (indeksow innych wierzcholkow)
     int neighbor_count;    // liczba sasiadow
-    int part_id;           // numer przypisanej partycji (-1 jesli brak)
     int neighbor_capacity; // pojemnosc tablicy sasiadow (do dynamicznej alokacji)
 } Node;
 
@@ -27,10 +30,74 @@ typedef struct Graph
     int min_count; // minimalna liczba wierzcholkow w czesci
     int max_count; // maksymalna liczba wierzcholkow w czesci
     Node *nodes;   // tablica wszystkich wierzcholkow
+    void *part_ids;    // gesta tablica przypisan wierzcholkow do czesci
+    int part_id_width; // rozmiar elementu tablicy przypisan w bajtach (1, 2 lub 4)
+    int *part_sizes;   // liczba wierzcholkow w kazdej czesci, aktualizowana przez set_part_id
+    struct Sell_graph *sell; // opcjonalny uklad SELL-C-sigma dla jadr SIMD (NULL jesli nieuzywany)
+    struct Quotient_graph *quotient; // graf ilorazowy czesci, aktualizowany przez set_part_id (NULL jesli nieuzywany)
+    int *pinned;       // czesc do ktorej wierzcholek jest przypiety (-1 jesli wolny), NULL gdy brak przypiec
+    int *coord_rows;   // wiersz wierzcholka w siatce z pliku csrrg, NULL gdy brak wspolrzednych
+    int *coord_cols;   // kolumna wierzcholka w siatce z pliku csrrg, NULL gdy brak wspolrzednych
 } Graph;
 
+// wartosci oznaczajace brak przypisania w tablicach 8- i 16-bitowych
+#define PART_ID_UNASSIGNED_U8 0xFF
+#define PART_ID_UNASSIGNED_U16 0xFFFF
+
+// zwraca numer czesci wierzcholka (-1 jesli brak)
+static inline int get_part_id(const Graph *graph, int vertex)
+{
+    if (graph->part_id_width == 1)
+    {
+        uint8_t part = ((const uint8_t *)graph->part_ids)[vertex];
+        return part == PART_ID_UNASSIGNED_U8 ? -1 : part;
+    }
+    if (graph->part_id_width == 2)
+    {
+        uint16_t part = ((const uint16_t *)graph->part_ids)[vertex];
+        return part == PART_ID_UNASSIGNED_U16 ? -1 : part;
+    }
+    return ((const int32_t *)graph->part_ids)[vertex];
+}
+
+// sprawdza czy wierzcholek jest przypiety do czesci
+static inline int is_pinned(const Graph *graph, int vertex)
+{
+    return graph->pinned && graph->pinned[vertex] >= 0;
+}
+
+// aktualizuje graf ilorazowy po ruchu wierzcholka (quotient_graph.c)
+void quotient_move_vertex(struct Quotient_graph *quotient, const Graph *graph, int vertex, int from, int to);
+
+// przypisuje wierzcholek do czesci (-1 usuwa przypisanie)
+static inline void set_part_id(Graph *graph, int vertex, int part_id)
+{
+    int old_part = -1;
+    if (graph->part_sizes || graph->quotient)
+        old_part = get_part_id(graph, vertex);
+
+    if (graph->part_sizes)
+    {
+        if (old_part >= 0)
+            graph->part_sizes[old_part]--;
+        if (part_id >= 0)
+            graph->part_sizes[part_id]++;
+    }
+
+    if (graph->part_id_width == 1)
+        ((uint8_t *)graph->part_ids)[vertex] = part_id < 0 ? PART_ID_UNASSIGNED_U8 : (uint8_t)part_id;
+    else if (graph->part_id_width == 2)
+        ((uint16_t *)graph->part_ids)[vertex] = part_id < 0 ? PART_ID_UNASSIGNED_U16 : (uint16_t)part_id;
+    else
+        ((int32_t *)graph->part_ids)[vertex] = part_id;
+
+    // graf ilorazowy czyta czesci sasiadow, wiec aktualizujemy go po zapisie
+    if (graph->quotient && old_part != part_id)
+        quotient_move_vertex(graph->quotient, graph, vertex, old_part, part_id);
+}
+
 // wypisuje sasiadow dla wierzcholkow partycji
-void print_part_neighbors(int **neighbors, int size);
+void print_part_neighbors(const struct Part_neighbors *part_neighbors);
 
 // tworzy nowy graf o podanej liczbie wierzcholkow
 void inicialize_graph(Graph *graph, int vertices);
@@ -42,8 +109,14 @@ void count_edges(Graph *graph);
 void assign_min_max_count(Graph *graph, int parts, float accuracy);
 
 // ustawia liczbe czesci grafu
+// dobiera tez szerokosc tablicy przypisan do liczby czesci
 void assing_parts(Graph *graph, int parts);
 
+// alokuje lub przepakowuje tablice przypisan do szerokosci wystarczajacej dla podanej liczby czesci
+// istniejace przypisania sa zachowywane, nowa tablica jest wypelniona wartoscia -1
+// przelicza tez rozmiary czesci w part_sizes
+void initialize_part_ids(Graph *graph, int parts);
+
 // zwalnia pamiec zajmowana przez graf
 void free_graph(Graph *graph);
 
@@ -0,0 +1,45 @@
+#ifndef HALO_H
+#define HALO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graph.h"
+#include "bfs_engine.h"
+
+// warstwa duchow (halo) czesci - wierzcholki innych czesci w odleglosci co najwyzej hops
+// od czesci razem z krawedziami, ktore je lacza, zeby obliczenia rozproszone nie musialy
+// wczytywac calego grafu w poszukiwaniu sasiadow zewnetrznych
+typedef struct Part_halo
+{
+    int part;           // numer czesci
+    int boundary_count; // liczba wierzcholkow brzegowych
+    int *boundary;      // wierzcholki czesci z sasiadem w innej czesci, rosnaco
+    int ghost_count;    // liczba duchow
+    int *ghosts;        // wierzcholki halo w kolejnosci BFS (rosnaca odleglosc)
+    int *ghost_owner;   // czesc, do ktorej nalezy duch
+    int *ghost_hop;     // odleglosc ducha od czesci (1..hops)
+    int edge_count;     // liczba krawedzi halo
+    int *edges;         // pary (u, v): u w czesci lub duch, v duch, kazda krawedz raz
+} Part_halo;
+
+// warstwy duchow wszystkich czesci
+typedef struct Halo_layer
+{
+    int parts;        // liczba czesci
+    int hops;         // glebokosc halo
+    Part_halo *halos; // halo kazdej czesci
+} Halo_layer;
+
+// liczy brzeg i halo o glebokosci hops kazdej czesci, czesci sa przetwarzane rownolegle
+// wierzcholki bez przypisania nie naleza do zadnego halo
+void build_halo_layer(const Graph *graph, int parts, int hops, Halo_layer *layer);
+
+// zwalnia warstwy duchow
+void free_halo_layer(Halo_layer *layer);
+
+// zapisuje warstwy duchow do pliku tekstowego obok wyniku podzialu
+// zwraca 1 przy powodzeniu, 0 gdy plik nie mogl byc zapisany
+int write_halo_file(const char *filename, const Graph *graph, const Halo_layer *layer);
+
+#endif
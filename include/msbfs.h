@@ -0,0 +1,66 @@
+#ifndef MSBFS_H
+#define MSBFS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "graph.h"
+
+// liczba 64-bitowych slow maski zrodel, z AVX2 maska ma 256 bitow i jest przetwarzana jednym rejestrem
+#if defined(__AVX2__)
+#define MSBFS_WORDS 4
+#else
+#define MSBFS_WORDS 1
+#endif
+
+// maksymalna liczba zrodel przechodzonych jednym przebiegiem
+#define MSBFS_MAX_SOURCES (64 * MSBFS_WORDS)
+
+// maska zrodel - bit i oznacza zrodlo sources[i]
+typedef struct Msbfs_mask
+{
+    uint64_t words[MSBFS_WORDS];
+} __attribute__((aligned(8 * MSBFS_WORDS))) Msbfs_mask;
+
+// bufory wielozrodlowego BFS, tworzone raz i uzywane przez wiele przebiegow
+// po kazdym przebiegu zerowane sa tylko maski odwiedzonych wierzcholkow
+typedef struct Msbfs_state
+{
+    int vertices;       // liczba wierzcholkow grafu
+    Msbfs_mask *seen;   // zrodla ktore juz dotarly do wierzcholka
+    Msbfs_mask *visit;  // zrodla we froncie biezacego poziomu
+    Msbfs_mask *next;   // zrodla we froncie nastepnego poziomu
+    int *frontier;      // wierzcholki z niepusta maska visit
+    int *next_frontier; // wierzcholki z niepusta maska next
+    int *touched;       // wierzcholki z niepusta maska seen (do wyzerowania)
+    int touched_count;  // liczba wierzcholkow w touched
+} Msbfs_state;
+
+// wywolywana dla kazdego wierzcholka osiagnietego na poziomie level przez nowe zrodla reached
+// zwrocenie wartosci roznej od zera konczy przeszukiwanie
+typedef int (*Msbfs_visit)(void *arg, int vertex, int level, const Msbfs_mask *reached);
+
+// tworzy bufory dla grafu o podanej liczbie wierzcholkow
+Msbfs_state *create_msbfs_state(int vertices);
+
+// zwalnia bufory
+void free_msbfs_state(Msbfs_state *state);
+
+// BFS z maksymalnie MSBFS_MAX_SOURCES zrodel naraz - jedno przejscie po sasiedztwie
+// rozwija wszystkie zrodla, ktore maja wierzcholek w biezacym froncie
+// max_level < 0 oznacza brak ograniczenia glebokosci, zwraca numer ostatniego poziomu
+int multi_source_bfs(const Graph *graph, Msbfs_state *state, const int *sources, int source_count,
+                     int max_level, Msbfs_visit visit, void *arg);
+
+// dla kazdego kandydata liczy odleglosc do najblizszego wierzcholka oznaczonego w is_target
+// kandydaci sa przetwarzani paczkami po MSBFS_MAX_SOURCES, -1 oznacza brak sciezki
+void nearest_target_distances(const Graph *graph, Msbfs_state *state, const int *candidates, int candidate_count,
+                              const unsigned char *is_target, int *distances);
+
+// szacuje srednice grafu jako najwieksza ekscentrycznosc sposrod podanych wierzcholkow
+// jesli eccentricity nie jest NULL, zapisuje w nim ekscentrycznosc kazdego z nich
+int estimate_pseudo_diameter(const Graph *graph, Msbfs_state *state, const int *sources, int source_count,
+                             int *eccentricity);
+
+#endif
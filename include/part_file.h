@@ -0,0 +1,67 @@
+#ifndef PART_FILE_H
+#define PART_FILE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "graph.h"
+
+// plik .part - sam wektor przypisan wierzcholek -> czesc
+// naglowek ma 32 bajty, dalej wpisy po PART_FILE_BITS(parts) bitow upakowane w slowach 64-bitowych
+// (little-endian), wpis wierzcholka v zaczyna sie od bitu v * bits
+#define PART_FILE_MAGIC "PART"
+#define PART_FILE_VERSION 1
+
+// naglowek pliku .part
+typedef struct Part_file_header
+{
+    char magic[4];        // "PART"
+    uint32_t version;     // wersja formatu
+    uint32_t vertices;    // liczba wierzcholkow
+    uint32_t parts;       // liczba czesci
+    uint32_t bits;        // liczba bitow na wpis, ceil(log2(parts)) ale co najmniej 1
+    uint32_t reserved[3]; // zera, dopelnienie do 32 bajtow zeby dane byly wyrownane
+} Part_file_header;
+
+// plik .part otwarty przez mmap
+typedef struct Part_file
+{
+    void *map;             // zmapowany plik
+    size_t length;         // dlugosc mapowania
+    uint32_t vertices;     // liczba wierzcholkow
+    uint32_t parts;        // liczba czesci
+    uint32_t bits;         // liczba bitow na wpis
+    const uint64_t *words; // upakowane wpisy
+} Part_file;
+
+// liczba bitow potrzebna na numer czesci
+uint32_t part_file_bits(uint32_t parts);
+
+// zapisuje przypisania wszystkich wierzcholkow do pliku .part
+// zwraca 1 przy powodzeniu, 0 gdy plik nie mogl byc zapisany albo wierzcholek nie ma czesci
+int write_part_file(const char *filename, const Graph *graph);
+
+// otwiera plik .part przez mmap i sprawdza naglowek
+// zwraca 1 przy powodzeniu, 0 przy bledzie
+int open_part_file(const char *filename, Part_file *file);
+
+// zamyka plik otwarty przez open_part_file
+void close_part_file(Part_file *file);
+
+// zwraca czesc wierzcholka w czasie O(1)
+static inline int part_file_lookup(const Part_file *file, uint32_t vertex)
+{
+    uint64_t bit = (uint64_t)vertex * file->bits;
+    uint64_t word = bit >> 6;
+    uint32_t shift = bit & 63;
+    uint64_t value = file->words[word] >> shift;
+
+    // wpis przechodzi na nastepne slowo
+    if (shift + file->bits > 64)
+        value |= file->words[word + 1] << (64 - shift);
+
+    return (int)(value & ((UINT64_C(1) << file->bits) - 1));
+}
+
+#endif
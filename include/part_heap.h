@@ -0,0 +1,45 @@
+#ifndef PART_HEAP_H
+#define PART_HEAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// indeksowany kopiec minimalny czesci - kluczem jest zewnetrzna tablica (np. rozmiary czesci)
+// pozycja kazdej czesci w kopcu jest pamietana, wiec zmiana klucza i usuniecie kosztuja O(log k)
+// przy rownych kluczach wygrywa czesc o mniejszym numerze
+typedef struct Part_heap
+{
+    int size;        // liczba czesci w kopcu
+    int *heap;       // czesci w porzadku kopca
+    int *position;   // pozycja czesci w kopcu, -1 gdy jej nie ma
+    const int *keys; // klucze czesci
+} Part_heap;
+
+// tworzy pusty kopiec dla czesci 0..parts-1 z kluczami z tablicy keys
+Part_heap *create_part_heap(int parts, const int *keys);
+
+// zwalnia kopiec
+void free_part_heap(Part_heap *heap);
+
+// dodaje czesc do kopca
+void part_heap_push(Part_heap *heap, int part);
+
+// usuwa czesc z kopca, jesli w nim jest
+void part_heap_remove(Part_heap *heap, int part);
+
+// przywraca porzadek po zmianie klucza czesci
+void part_heap_update(Part_heap *heap, int part);
+
+// czesc o najmniejszym kluczu albo -1 dla pustego kopca
+static inline int part_heap_top(const Part_heap *heap)
+{
+    return heap->size > 0 ? heap->heap[0] : -1;
+}
+
+// sprawdza czy czesc jest w kopcu
+static inline int part_heap_contains(const Part_heap *heap, int part)
+{
+    return heap->position[part] >= 0;
+}
+
+#endif
@@ -11,19 +11,24 @@ struct Graph;
 typedef struct Graph Graph;
 
 // struktura opisujaca pojedyncza czesc grafu
+// lista wierzcholkow jest fragmentem wspolnego bufora Partition_data
 typedef struct Part
 {
     int part_id;           // identyfikator czesci
     int part_vertex_count; // liczba wierzcholkow w czesci
-    int *part_vertexes;    // tablica indeksow wierzcholkow w tej czesci
-    int capacity;          // aktualna pojemnosc tablicy (do dynamicznego powiekszania)
+    int *part_vertexes;    // wierzcholki czesci (wskaznik do wspolnego bufora, rosnaco)
 } Part;
 
-// struktura przechowujaca dane o calym podziale grafu na czesci
+// widok podzialu grafu na czesci, odtwarzany z tablicy przypisan grafu
+// wierzcholki wszystkich czesci leza w jednym buforze, czesc i zajmuje
+// vertices[offsets[i]] .. vertices[offsets[i + 1] - 1]
 typedef struct Partition_data
 {
-    int parts_count; // liczba czesci w podziale
-    Part *parts;     // tablica wszystkich czesci
+    int parts_count;     // liczba czesci w podziale
+    Part *parts;         // tablica wszystkich czesci
+    int *offsets;        // poczatki czesci w buforze (parts_count + 1 elementow)
+    int *vertices;       // wspolny bufor wierzcholkow posortowanych wedlug czesci
+    int vertex_capacity; // pojemnosc bufora
 } Partition_data;
 
 // inicjalizuje strukture danych partycji z okreslona liczba czesci
@@ -32,12 +37,30 @@ void initialize_partition_data(Partition_data *partition_data, int parts);
 // zwalnia pamiec zaalokowana dla struktury partycji
 void free_partition_data(Partition_data *partition_data, int parts);
 
-// dodaje wierzcholek o podanym indeksie do wskazanej czesci
-void add_partition_data(Partition_data *partition_data, int part_id, int vertex);
+// sprawdza czy wierzcholek nalezy do danej czesci (O(1), wedlug tablicy przypisan grafu)
+// zwraca 1 jesli tak, 0 jesli nie
+int is_in_partition(const Graph *graph, int part_id, int vertex);
 
-// znajduje wszystkich sasiadow wierzcholkow w danej czesci grafu
-// zwraca tablice tablic sasiadow dla kazdego wierzcholka
-int **get_part_neighbors(const Graph *graph, const Partition_data *partition_data, int part_id, int *size);
+// odbudowuje listy wierzcholkow czesci z tablicy przypisan grafu
+// jedno przejscie sortowania przez zliczanie do wspolnego bufora
+void rebuild_partition_data(Partition_data *partition_data, const Graph *graph);
+
+// sasiedztwo wewnatrz jednej czesci w ukladzie CSR
+// sasiedzi wierzcholka vertices[i] to neighbors[offsets[i]] .. neighbors[offsets[i + 1] - 1]
+typedef struct Part_neighbors
+{
+    int size;       // liczba wierzcholkow czesci
+    int *vertices;  // wierzcholki czesci, rosnaco
+    int *offsets;   // poczatki list sasiadow (size + 1 elementow)
+    int *neighbors; // sasiedzi z tej samej czesci, rosnaco dla kazdego wierzcholka
+} Part_neighbors;
+
+// znajduje sasiadow wierzcholkow danej czesci lezacych w tej samej czesci
+// wypelnia result trzema ciaglymi tablicami, zwraca 1 przy powodzeniu i 0 przy bledzie
+int get_part_neighbors(const Graph *graph, const Partition_data *partition_data, int part_id, Part_neighbors *result);
+
+// zwalnia tablice wyniku get_part_neighbors
+void free_part_neighbors(Part_neighbors *part_neighbors);
 
 // wypisuje informacje o podziale grafu na czesci
 void print_partition_data(const Partition_data *partition_data);
@@ -0,0 +1,40 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "graph.h"
+#include "partition.h"
+#include "region_growing.h"
+#include "fm_optimization.h"
+#include "thread_pool.h"
+#include "random.h"
+
+// ustawienia portfela niezaleznych prob podzialu
+typedef struct Portfolio_settings
+{
+    int restarts;         // liczba prob (region growing + FM)
+    int fm_iterations;    // limit iteracji FM w kazdej probie
+    int parallel_growing; // czy proba uzywa parallel_region_growing
+    float accuracy;       // dokladnosc podzialu
+    uint64_t seed;        // ziarno bazowe, proba i dostaje ziarno seed + i
+} Portfolio_settings;
+
+// wynik portfela
+typedef struct Portfolio_result
+{
+    int best_trial; // numer najlepszej proby
+    int best_cut;   // liczba przecietych krawedzi najlepszej proby
+    int balanced;   // czy najlepsza proba miesci sie w granicach min_count..max_count
+} Portfolio_result;
+
+// uruchamia niezalezne proby rownolegle na wspolnej puli watkow
+// kazda proba ma wlasna tablice przypisan i wlasny generator liczb losowych, a dzieli z reszta
+// tylko sasiedztwo grafu; wygrywa podzial zbalansowany o najmniejszym przecieciu (przy remisie
+// proba o mniejszym numerze), jego przypisania trafiaja do graph i partition_data
+Portfolio_result run_portfolio(Graph *graph, int parts, Partition_data *partition_data,
+                               const Portfolio_settings *settings);
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef QUOTIENT_GRAPH_H
+#define QUOTIENT_GRAPH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graph.h"
+
+// graf ilorazowy czesci - wierzcholkami sa czesci, krawedz p-r istnieje gdy
+// miedzy czesciami p i r lezy co najmniej jedna przecieta krawedz grafu
+// po zbudowaniu jest aktualizowany przez set_part_id w czasie O(stopien) na ruch
+typedef struct Quotient_graph
+{
+    int parts;            // liczba czesci
+    int vertices;         // liczba wierzcholkow grafu
+    int *degree;          // liczba sasiednich czesci
+    int *capacity;        // pojemnosc list sasiednich czesci
+    int **adjacent;       // sasiednie czesci
+    int **weights;        // liczba przecietych krawedzi do sasiedniej czesci
+    int *boundary_count;  // liczba wierzcholkow granicznych w czesci
+    int *external_degree; // liczba sasiadow wierzcholka w innych czesciach
+    long total_cut;       // liczba wszystkich przecietych krawedzi
+} Quotient_graph;
+
+// buduje graf ilorazowy z biezacego podzialu grafu w czasie O(V + E)
+Quotient_graph *build_quotient_graph(const Graph *graph);
+
+// zwalnia graf ilorazowy
+void free_quotient_graph(Quotient_graph *quotient);
+
+// uwzglednia przeniesienie wierzcholka z czesci from do to (-1 oznacza brak przypisania)
+// wywolywane przez set_part_id po zapisaniu nowej czesci
+void quotient_move_vertex(Quotient_graph *quotient, const Graph *graph, int vertex, int from, int to);
+
+// zwraca liczbe przecietych krawedzi miedzy czesciami a i b
+int quotient_cut_weight(const Quotient_graph *quotient, int a, int b);
+
+// zwraca liczbe przecietych krawedzi wychodzacych z czesci
+int quotient_part_cut(const Quotient_graph *quotient, int part);
+
+// wypisuje niezerowe pozycje macierzy przeciec miedzy czesciami
+void print_quotient_graph(const Quotient_graph *quotient);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+// szybki generator liczb losowych xoshiro256** ze stanem osobnym dla kazdego watku
+// watki uruchamiajace niezalezne proby ustawiaja wlasne ziarno, wiec wyniki sa powtarzalne
+// watek bez ustawionego ziarna inicjalizuje stan z czasu przy pierwszym uzyciu
+
+// ustawia ziarno generatora biezacego watku, stan jest rozwijany przez splitmix64
+void seed_random(uint64_t seed);
+
+// zwraca nastepna 64-bitowa liczbe losowa biezacego watku
+uint64_t next_random(void);
+
+// zwraca liczbe losowa z przedzialu [0, bound)
+int random_below(int bound);
+
+// zwraca liczbe losowa z przedzialu [0, 1)
+double random_unit(void);
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef RECURSIVE_BISECTION_H
+#define RECURSIVE_BISECTION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "graph.h"
+#include "partition.h"
+#include "thread_pool.h"
+
+// liczba przebiegow dwuczesciowego FM po kazdej bisekcji
+#define BISECTION_FM_PASSES 2
+
+// przebieg FM konczy sie po tylu ruchach bez poprawy ciecia
+#define BISECTION_FM_STALL 64
+
+// podzial przez rekurencyjna bisekcje podgrafow indukowanych
+// kazdy podproblem dzieli sie na dwie czesci o rozmiarach proporcjonalnych do liczby czesci po obu
+// stronach (parts / 2 i reszta, wiec dziala tez dla liczby czesci niebedacej potega dwojki);
+// podzial startowy to prefiks kolejnosci BFS od wierzcholka peryferyjnego, poprawiany dwuczesciowym FM
+// podproblemy jednego poziomu sa niezalezne i ida jako zadania puli watkow;
+// dopuszczalna nierownowaga poziomu to (1 + accuracy)^(1 / liczba poziomow) - 1, wiec po wszystkich
+// poziomach czesci mieszcza sie w dokladnosci; przypiete wierzcholki zawsze ida na strone swojej czesci
+// zwraca 1 gdy podzial miesci sie w dokladnosci
+int recursive_bisection_partition(Graph *graph, int parts, Partition_data *partition_data, float accuracy);
+
+#endif
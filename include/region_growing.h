@@ -3,6 +3,13 @@
 
 #include "graph.h"
 #include "partition.h"
+#include "traversal.h"
+#include "bfs_engine.h"
+#include "msbfs.h"
+#include "bucket_queue.h"
+#include "part_heap.h"
+#include "random.h"
+#include "geometry.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -10,6 +17,19 @@
 #include <math.h>
 #include <stdbool.h>
 
+// liczba losowanych kandydatow na kazdy punkt startowy
+// odpowiada liczbie zrodel jednego przebiegu wielozrodlowego BFS
+#define SEED_CANDIDATES MSBFS_MAX_SOURCES
+
+// sposob wybierania punktow startowych czesci
+typedef enum Seeding_mode
+{
+    SEEDING_KCENTER,  // wierzcholek pseudo-peryferyjny, potem zawsze najdalszy od wybranych punktow
+    SEEDING_D2,       // jak k-center, ale kolejny punkt losowany z wagami rownymi kwadratowi odleglosci
+    SEEDING_SAMPLED,  // najdalszy z SEED_CANDIDATES losowych kandydatow
+    SEEDING_GEOMETRIC // srodki rownych odcinkow krzywej Hilberta (wymaga wspolrzednych, bez nich k-center)
+} Seeding_mode;
+
 // struktura kolejki do przechodzenia grafu algorytmem BFS
 // uzywana przy sprawdzaniu spojnosci partycji
 struct Queue
@@ -33,7 +53,21 @@ void remove_from_queue(struct Queue *queue);
 // zwraca 1 jesli podzial sie powiodl w granicach dokladnosci, 0 w przeciwnym razie
 int region_growing(Graph *graph, int parts, Partition_data *partition_data, float accuracy);
 
-// losuje wierzcholki startowe dla kazdej partycji
+// rownolegla wersja region_growing - wszystkie czesci rosna jednoczesnie na wspolnej puli watkow
+// wierzcholki sa zajmowane przez compare-and-swap na tablicy przypisan, czesci rosna rundami
+// o staly krok az do max_vertices_per_part, reszte przypisuje to samo zakonczenie co w wersji szeregowej
+int parallel_region_growing(Graph *graph, int parts, Partition_data *partition_data, float accuracy);
+
+// konczy podzial: przypisuje wierzcholki bez czesci, sprawdza dokladnosc, naprawia spojnosc
+// i odtwarza listy czesci; part_counts to rozmiary czesci zgodne z tablica przypisan
+// zwraca 1 gdy podzial miesci sie w dokladnosci
+int complete_partition(Graph *graph, int parts, Partition_data *partition_data, int *part_counts, float accuracy);
+
+// ustawia sposob wybierania punktow startowych (domyslnie SEEDING_KCENTER)
+void set_seeding_mode(Seeding_mode mode);
+
+// wybiera wierzcholki startowe dla kazdej partycji zgodnie z ustawionym sposobem
+// przypiete wierzcholki sa punktami swoich czesci, pozostale punkty trafiaja daleko od nich
 // zwraca tablice indeksow wierzcholkow startowych
 int *generate_seed_points(Graph *graph, int parts);
 
@@ -41,4 +75,15 @@ int *generate_seed_points(Graph *graph, int parts);
 // wypisuje informacje o spojnosci kazdej partycji
 void check_partition_connectivity(Graph *graph, int parts);
 
+// sprawdza spojnosc pojedynczej partycji
+// zwraca 1 jesli partycja jest spojna, 0 w przeciwnym razie
+int verify_partition_connectivity(Graph *graph, int part_id);
+
+// naprawia spojnosc wszystkich partycji w czasie O(E * alfa)
+// skladowe czesci wyznacza jedno przejscie union-find po krawedziach wewnatrz czesci,
+// kazda czesc zachowuje najwieksza skladowa (i skladowe z przypietymi wierzcholkami),
+// reszte rozdziela jeden wielozrodlowy BFS do sasiednich czesci o najmniejszym rozmiarze
+// zwraca liczbe przeniesionych wierzcholkow
+int repair_partition_connectivity(Graph *graph, int parts, int *part_counts);
+
 #endif // REGION_GROWING_H
@@ -0,0 +1,60 @@
+#ifndef SELL_GRAPH_H
+#define SELL_GRAPH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "graph.h"
+
+// szerokosc plastra - tyle wierzcholkow jest przetwarzanych naraz w lini SIMD
+#if defined(__AVX512F__)
+#define SELL_CHUNK 16
+#else
+#define SELL_CHUNK 8
+#endif
+
+// okno sortowania wierzcholkow wedlug stopnia (sigma), ogranicza wypelnienie plastrow
+#define SELL_SIGMA 256
+
+// uklad wybierany automatycznie gdy wariancja stopni nie przekracza sredniego stopnia
+#define SELL_MAX_DISPERSION 1.0
+
+// sasiedztwo w ukladzie SELL-C-sigma (sliced ELLPACK)
+// wiersze (wierzcholki) sa posortowane malejaco wedlug stopnia w oknach SELL_SIGMA
+// i podzielone na plastry po SELL_CHUNK wierszy, w plastrze j-ty sasiad kolejnych wierszy
+// lezy obok siebie, wiec petla po sasiadach idzie rownolegle dla calego plastra
+typedef struct Sell_graph
+{
+    int vertices;        // liczba wierzcholkow
+    int slices;          // liczba plastrow
+    int *slice_offsets;  // poczatek plastra w columns (slices + 1 elementow)
+    int *slice_widths;   // najwiekszy stopien w plastrze
+    int *row_vertex;     // wierzcholek w danym wierszu (-1 dla wierszy dopelnienia)
+    int *row_degree;     // stopien wierzcholka w danym wierszu
+    int *columns;        // sasiedzi, kolumnami w plastrze, dopelnienie wskazuje sam wierzcholek
+    long padded_entries; // liczba pozycji razem z dopelnieniem
+} Sell_graph;
+
+// buduje uklad SELL-C-sigma z list sasiedztwa grafu
+Sell_graph *build_sell_graph(const Graph *graph);
+
+// buduje uklad tylko jesli rozklad stopni jest na tyle rowny, ze dopelnienie sie oplaca
+// zwraca NULL jesli graf lepiej przetwarzac w zwyklym ukladzie
+Sell_graph *build_sell_graph_if_suitable(const Graph *graph);
+
+// zwalnia uklad
+void free_sell_graph(Sell_graph *sell);
+
+// liczy dla kazdego wierzcholka liczbe sasiadow w tej samej czesci (stopien wewnetrzny)
+// z niego wynikaja: wierzcholki graniczne (wewnetrzny < stopien), liczba przeciec
+// i gorne ograniczenie zysku ruchu (stopien - 2 * wewnetrzny)
+void sell_internal_degrees(const Graph *graph, const Sell_graph *sell, int *internal);
+
+// oznacza wierzcholki majace sasiada w innej czesci
+void sell_identify_boundary(const Graph *graph, const Sell_graph *sell, bool *is_boundary);
+
+// liczy krawedzie przeciete przez podzial
+int sell_count_cut_edges(const Graph *graph, const Sell_graph *sell);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef SPECTRAL_H
+#define SPECTRAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "graph.h"
+#include "partition.h"
+#include "thread_pool.h"
+
+// najwieksza liczba krokow Lanczosa w jednym cyklu (rozmiar bazy Krylowa)
+#define SPECTRAL_LANCZOS_STEPS 48
+
+// najwieksza liczba cykli Lanczosa restartowanych od wektora Ritza
+#define SPECTRAL_RESTARTS 12
+
+// co tyle krokow Lanczosa sprawdzana jest zbieznosc
+#define SPECTRAL_CHECK_STEPS 8
+
+// wzgledna dokladnosc wektora Fiedlera - do podzialu wystarcza przyblizony
+#define SPECTRAL_TOLERANCE 1e-3
+
+// liczba wierszy w bloku mnozenia - jedno zadanie puli, x dla bloku miesci sie w pamieci podrecznej
+#define SPMV_BLOCK_ROWS 2048
+
+// laplasjan L = D - A podgrafu indukowanego w ukladzie CSR z numeracja lokalna
+typedef struct Laplacian
+{
+    int rows;       // liczba wierszy (wierzcholkow podgrafu)
+    int *offsets;   // poczatek wiersza w columns (rows + 1 elementow)
+    int *columns;   // lokalne numery sasiadow, rosnaco
+    double *degree; // stopien wierzcholka w podgrafie (przekatna L)
+} Laplacian;
+
+// buduje laplasjan podgrafu indukowanego przez vertices[0..count)
+// local to bufor rozmiaru graph->vertices wypelniony -1, po wyjsciu znow wypelniony -1
+void build_laplacian(const Graph *graph, const int *vertices, int count, int *local, Laplacian *laplacian);
+
+// zwalnia laplasjan
+void free_laplacian(Laplacian *laplacian);
+
+// y = L x, wiersze sa mnozone blokami SPMV_BLOCK_ROWS na wspolnej puli watkow,
+// a suma sasiadow wiersza pobiera x instrukcja gather (AVX-512 / AVX2) gdy jest dostepna
+void laplacian_multiply(const Laplacian *laplacian, const double *x, double *y);
+
+// liczy przyblizony wektor Fiedlera (wektor wlasny drugiej najmniejszej wartosci wlasnej L)
+// metoda Lanczosa z pelna reortogonalizacja, wektor staly jest usuwany z bazy
+void fiedler_vector(const Laplacian *laplacian, double *fiedler);
+
+// podzial wstepny przez rekurencyjna bisekcje spektralna
+// kazdy podzbior jest dzielony wedlug wektora Fiedlera swojego podgrafu na czesci o rozmiarach
+// proporcjonalnych do liczby czesci po obu stronach, zakonczenie jak w region growing
+// zwraca 1 gdy podzial miesci sie w dokladnosci, 0 w przeciwnym razie
+int spectral_partition(Graph *graph, int parts, Partition_data *partition_data, float accuracy);
+
+#endif
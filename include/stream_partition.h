@@ -0,0 +1,39 @@
+#ifndef STREAM_PARTITION_H
+#define STREAM_PARTITION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "graph.h"
+
+// rozmiar bufora odczytu strumienia
+#define STREAM_BUFFER_SIZE (1 << 16)
+
+// liczba glosow (czesc, licznik) pamietanych dla wierzcholka przed wczytaniem jego grupy
+// pliki csrrg zapisuja krawedz raz, w grupie mniejszego wierzcholka, wiec wczesniejszych sasiadow
+// wierzcholek poznaje tylko przez glosy zostawione, gdy pojawil sie w ich grupach
+#define STREAM_VOTE_SLOTS 4
+
+// wykladnik kary za rozmiar czesci w ocenie Fennel
+#define FENNEL_GAMMA 1.5
+
+// sposob oceny czesci dla wierzcholka w podziale strumieniowym
+typedef enum Stream_scoring
+{
+    STREAM_LDG,   // liczba sasiadow w czesci razy (1 - rozmiar / pojemnosc)
+    STREAM_FENNEL // liczba sasiadow w czesci minus krancowy koszt rozmiaru alfa * gamma * rozmiar^(gamma - 1)
+} Stream_scoring;
+
+// podzial strumieniowy pliku csrrg w jednym przejsciu po krawedziach
+// grupa i czwartej linii to sasiedzi wierzcholka i (jak w load_graph), wierzcholek dostaje czesc od razu
+// po wczytaniu swojej grupy, na podstawie juz przypisanych sasiadow i rozmiarow czesci;
+// wierzcholki bez wlasnej grupy ida od razu za wierzcholkiem grupy, w ktorej wystapily
+// przypisany wierzcholek grupy zostawia glos na swoja czesc kazdemu wolnemu sasiadowi z grupy, glosy sa
+// liczone razem z przypisanymi sasiadami z listy (najczestsze czesci wedlug Misra-Gries, O(V) pamieci)
+// listy sasiadow nie sa budowane - graf dostaje tylko liczbe wierzcholkow i tablice przypisan
+// (nodes == NULL), pamiec jest O(V), pojemnosc czesci wynika z dokladnosci
+// zwraca 1 przy powodzeniu, 0 gdy plik nie mogl byc odczytany
+int stream_partition(const char *filename, int parts, float accuracy, Stream_scoring scoring, Graph *graph);
+
+#endif
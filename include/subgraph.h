@@ -0,0 +1,36 @@
+#ifndef SUBGRAPH_H
+#define SUBGRAPH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graph.h"
+#include "bfs_engine.h"
+
+// podgraf jednej czesci z lokalna numeracja 0..vertices-1
+// kolejnosc lokalna jest rosnaca wedlug numerow globalnych
+typedef struct Part_subgraph
+{
+    int part;             // numer czesci
+    int vertices;         // liczba wierzcholkow czesci
+    int *local_to_global; // numer globalny wierzcholka lokalnego
+    int *offsets;         // poczatek sasiadow wierzcholka lokalnego (vertices + 1 elementow)
+    int *neighbors;       // lokalni sasiedzi wewnatrz czesci
+} Part_subgraph;
+
+// podgrafy wszystkich czesci
+typedef struct Subgraph_set
+{
+    int parts;                // liczba czesci
+    Part_subgraph *subgraphs; // podgraf kazdej czesci
+    int *global_to_local;     // numer lokalny wierzcholka w jego czesci, -1 dla nieprzypisanych
+} Subgraph_set;
+
+// wydziela podgrafy wszystkich czesci, czesci sa przetwarzane rownolegle
+// krawedzie przeciete sa pomijane, pozostale dostaja numery lokalne
+void extract_subgraphs(const Graph *graph, int parts, Subgraph_set *set);
+
+// zwalnia podgrafy
+void free_subgraphs(Subgraph_set *set);
+
+#endif
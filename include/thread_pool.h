@@ -0,0 +1,49 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+// funkcja wykonywana dla kazdego zadania, task to numer zadania od 0 do task_count - 1
+typedef void (*Task_function)(void *arg, int task);
+
+// prosta pula watkow wykonujaca petle rownolegle
+// zadania sa rozdzielane dynamicznie przez wspolny licznik, watek wywolujacy tez pracuje
+typedef struct Thread_pool
+{
+    pthread_t *threads;          // watki robocze
+    int thread_count;            // liczba watkow roboczych (bez watku wywolujacego)
+    pthread_mutex_t lock;        // chroni stan zlecenia
+    pthread_cond_t work_ready;   // sygnal nowego zlecenia
+    pthread_cond_t work_done;    // sygnal zakonczenia zlecenia
+    pthread_mutex_t submit_lock; // tylko jedno zlecenie naraz
+    Task_function function;      // biezaca funkcja
+    void *arg;                   // argument biezacej funkcji
+    int task_count;              // liczba zadan w zleceniu
+    int next_task;               // nastepne zadanie do pobrania
+    int active_workers;          // watki ktore jeszcze pracuja nad zleceniem
+    unsigned int generation;     // numer zlecenia, pozwala watkom odroznic nowe zlecenie
+    int shutdown;                // flaga zakonczenia pracy
+} Thread_pool;
+
+// tworzy pule z podana liczba watkow (lacznie z watkiem wywolujacym)
+Thread_pool *create_thread_pool(int threads);
+
+// konczy watki i zwalnia pule
+void destroy_thread_pool(Thread_pool *pool);
+
+// wykonuje function(arg, task) dla task = 0..task_count-1 i czeka na zakonczenie
+// wywolanie z wnetrza zadania wykonuje petle szeregowo, zeby uniknac zakleszczenia
+void parallel_for(Thread_pool *pool, int task_count, Task_function function, void *arg);
+
+// zwraca wspolna pule programu, tworzona przy pierwszym uzyciu
+Thread_pool *get_thread_pool(void);
+
+// ustawia liczbe watkow wspolnej puli (0 = liczba rdzeni), dziala przed pierwszym uzyciem lub odtwarza pule
+void set_thread_count(int threads);
+
+// zwalnia wspolna pule
+void release_thread_pool(void);
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef TRAVERSAL_H
+#define TRAVERSAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "graph.h"
+
+// wspolny bufor roboczy dla przejsc grafu (BFS, komponenty spojnosci)
+// zamiast zerowac tablice odwiedzonych przed kazdym przejsciem zwiekszamy numer epoki,
+// wierzcholek jest odwiedzony jesli jego znacznik jest rowny biezacej epoce
+// kazdy watek ma wlasna instancje, bufory rosna tylko gdy graf jest wiekszy niz poprzednio
+typedef struct Traversal_workspace
+{
+    int capacity;        // liczba wierzcholkow na ktora przygotowano bufory
+    unsigned int epoch;  // numer biezacego przejscia
+    unsigned int *marks; // epoka w ktorej wierzcholek zostal odwiedzony
+    int *queue;          // kolejka BFS
+    int *labels;         // dodatkowa etykieta wierzcholka (np. numer komponentu), wazna tylko dla odwiedzonych
+    uint64_t *bitmaps;   // bufor na mapy bitowe (frontier, nastepny frontier, odwiedzone)
+    size_t bitmap_words; // pojemnosc bufora map bitowych w slowach 64-bitowych
+} Traversal_workspace;
+
+// zwraca bufor roboczy biezacego watku przygotowany dla grafu o podanej liczbie wierzcholkow
+Traversal_workspace *get_traversal_workspace(int vertices);
+
+// zwalnia bufor roboczy biezacego watku (watki puli zwalniaja go automatycznie przy zakonczeniu)
+void release_traversal_workspace(void);
+
+// zwraca wyzerowany bufor na co najmniej words slow 64-bitowych z bufora watku
+uint64_t *get_bitmap_buffer(Traversal_workspace *workspace, size_t words);
+
+// rozpoczyna nowe przejscie - wszystkie wierzcholki staja sie nieodwiedzone w O(1)
+void begin_traversal(Traversal_workspace *workspace);
+
+// sprawdza czy wierzcholek zostal odwiedzony w biezacym przejsciu
+static inline int is_visited(const Traversal_workspace *workspace, int vertex)
+{
+    return workspace->marks[vertex] == workspace->epoch;
+}
+
+// oznacza wierzcholek jako odwiedzony, zwraca 1 jesli wczesniej nie byl odwiedzony
+static inline int mark_visited(Traversal_workspace *workspace, int vertex)
+{
+    if (workspace->marks[vertex] == workspace->epoch)
+        return 0;
+    workspace->marks[vertex] = workspace->epoch;
+    return 1;
+}
+
+// BFS po wierzcholkach czesci part_id zaczynajacy od start
+// skip_vertex (lub -1) jest traktowany jakby nie nalezal do czesci
+// zwraca liczbe odwiedzonych wierzcholkow, odwiedzone zostaja oznaczone w workspace
+int bfs_within_part(const Graph *graph, Traversal_workspace *workspace, int start, int part_id, int skip_vertex);
+
+// zwraca pierwszy wierzcholek czesci part_id rozny od skip_vertex lub -1 jesli takiego nie ma
+int find_part_vertex(const Graph *graph, int part_id, int skip_vertex);
+
+#endif
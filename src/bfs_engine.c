@@ -0,0 +1,236 @@
+#include "bfs_engine.h"
+
+// buduje indeks czesci sortowaniem przez zliczanie
+void build_part_index(const Graph *graph, int parts, Part_index *index)
+{
+    index->parts = parts;
+    index->offsets = calloc(parts + 1, sizeof(int));
+    index->members = malloc((graph->vertices > 0 ? graph->vertices : 1) * sizeof(int));
+    index->local_index = malloc((graph->vertices > 0 ? graph->vertices : 1) * sizeof(int));
+    if (!index->offsets || !index->members || !index->local_index)
+    {
+        perror("Blad alokacji pamieci dla indeksu czesci");
+        exit(EXIT_FAILURE);
+    }
+
+    // jedno przejscie zliczajace
+    for (int i = 0; i < graph->vertices; i++)
+    {
+        int part = get_part_id(graph, i);
+        if (part >= 0 && part < parts)
+            index->offsets[part + 1]++;
+    }
+    for (int p = 0; p < parts; p++)
+    {
+        index->offsets[p + 1] += index->offsets[p];
+    }
+
+    // rozkladamy wierzcholki, kolejnosc wewnatrz czesci jest rosnaca
+    int *cursor = malloc((parts > 0 ? parts : 1) * sizeof(int));
+    if (!cursor)
+    {
+        perror("Blad alokacji pamieci dla indeksu czesci");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(cursor, index->offsets, parts * sizeof(int));
+    for (int i = 0; i < graph->vertices; i++)
+    {
+        int part = get_part_id(graph, i);
+        if (part >= 0 && part < parts)
+        {
+            index->local_index[i] = cursor[part] - index->offsets[part];
+            index->members[cursor[part]++] = i;
+        }
+        else
+        {
+            index->local_index[i] = -1;
+        }
+    }
+    free(cursor);
+}
+
+// zwalnia indeks czesci
+void free_part_index(Part_index *index)
+{
+    free(index->offsets);
+    free(index->members);
+    free(index->local_index);
+    index->offsets = NULL;
+    index->members = NULL;
+    index->local_index = NULL;
+}
+
+// operacje na mapach bitowych
+static inline int test_bit(const uint64_t *bitmap, int bit)
+{
+    return (bitmap[bit >> 6] >> (bit & 63)) & 1;
+}
+
+static inline void set_bit(uint64_t *bitmap, int bit)
+{
+    bitmap[bit >> 6] |= (uint64_t)1 << (bit & 63);
+}
+
+// BFS zmieniajacy kierunek ograniczony do jednej czesci
+int bfs_part_reachable(const Graph *graph, const Part_index *index, int part_id)
+{
+    const int *members = index->members + index->offsets[part_id];
+    int size = index->offsets[part_id + 1] - index->offsets[part_id];
+    if (size <= 1)
+        return size;
+
+    // trzy mapy bitowe indeksowane pozycja wierzcholka w czesci
+    size_t words = ((size_t)size + 63) / 64;
+    Traversal_workspace *workspace = get_traversal_workspace(graph->vertices);
+    uint64_t *visited = get_bitmap_buffer(workspace, 3 * words);
+    uint64_t *frontier = visited + words;
+    uint64_t *next = frontier + words;
+
+    // krawedzie nieodwiedzonych wierzcholkow do heurystyki przelaczania
+    long unvisited_edges = 0;
+    for (int i = 0; i < size; i++)
+        unvisited_edges += graph->nodes[members[i]].neighbor_count;
+
+    set_bit(visited, 0);
+    set_bit(frontier, 0);
+    int reached = 1;
+    int frontier_count = 1;
+    long frontier_edges = graph->nodes[members[0]].neighbor_count;
+    unvisited_edges -= frontier_edges;
+    int bottom_up = 0;
+
+    while (frontier_count > 0)
+    {
+        // wybieramy kierunek kroku
+        if (!bottom_up && frontier_edges > unvisited_edges / BFS_ALPHA)
+            bottom_up = 1;
+        else if (bottom_up && frontier_count < size / BFS_BETA)
+            bottom_up = 0;
+
+        memset(next, 0, words * sizeof(uint64_t));
+        int next_count = 0;
+        long next_edges = 0;
+
+        if (!bottom_up)
+        {
+            // top-down: rozwijamy wierzcholki frontu
+            for (size_t w = 0; w < words; w++)
+            {
+                uint64_t bits = frontier[w];
+                while (bits)
+                {
+                    int local = (int)(w * 64) + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+                    const Node *node = &graph->nodes[members[local]];
+
+                    for (int j = 0; j < node->neighbor_count; j++)
+                    {
+                        int neighbor = node->neighbors[j];
+                        if (get_part_id(graph, neighbor) != part_id)
+                            continue;
+                        int neighbor_local = index->local_index[neighbor];
+                        if (!test_bit(visited, neighbor_local))
+                        {
+                            set_bit(visited, neighbor_local);
+                            set_bit(next, neighbor_local);
+                            next_count++;
+                            next_edges += graph->nodes[neighbor].neighbor_count;
+                        }
+                    }
+                }
+            }
+        }
+        else
+        {
+            // bottom-up: kazdy nieodwiedzony wierzcholek szuka rodzica we froncie
+            for (size_t w = 0; w < words; w++)
+            {
+                uint64_t bits = ~visited[w];
+                if (w == words - 1 && (size & 63))
+                    bits &= ((uint64_t)1 << (size & 63)) - 1;
+
+                while (bits)
+                {
+                    int local = (int)(w * 64) + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+                    const Node *node = &graph->nodes[members[local]];
+
+                    for (int j = 0; j < node->neighbor_count; j++)
+                    {
+                        int neighbor = node->neighbors[j];
+                        if (get_part_id(graph, neighbor) == part_id &&
+                            test_bit(frontier, index->local_index[neighbor]))
+                        {
+                            set_bit(visited, local);
+                            set_bit(next, local);
+                            next_count++;
+                            next_edges += node->neighbor_count;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        // zamieniamy fronty
+        uint64_t *swap = frontier;
+        frontier = next;
+        next = swap;
+        reached += next_count;
+        frontier_count = next_count;
+        frontier_edges = next_edges;
+        unvisited_edges -= next_edges;
+    }
+
+    return reached;
+}
+
+// dane wspolne dla zadan sprawdzania spojnosci
+typedef struct
+{
+    const Graph *graph;
+    const Part_index *index;
+    int *connected;
+} Connectivity_job;
+
+// zadanie puli - sprawdza jedna czesc
+static void check_part_task(void *arg, int part)
+{
+    Connectivity_job *job = arg;
+    int size = job->index->offsets[part + 1] - job->index->offsets[part];
+    job->connected[part] = (size <= 1) || bfs_part_reachable(job->graph, job->index, part) == size;
+}
+
+// sprawdza spojnosc wszystkich czesci
+int check_all_parts_connected(const Graph *graph, int parts, int *connected)
+{
+    if (parts <= 0)
+        return 1;
+
+    Part_index index;
+    build_part_index(graph, parts, &index);
+
+    int *results = connected ? connected : malloc(parts * sizeof(int));
+    if (!results)
+    {
+        perror("Blad alokacji pamieci dla wynikow spojnosci");
+        exit(EXIT_FAILURE);
+    }
+
+    // male grafy sprawdzamy szeregowo
+    Connectivity_job job = {graph, &index, results};
+    Thread_pool *pool = graph->vertices >= PARALLEL_BFS_MIN_VERTICES ? get_thread_pool() : NULL;
+    parallel_for(pool, parts, check_part_task, &job);
+
+    int all_connected = 1;
+    for (int p = 0; p < parts; p++)
+    {
+        if (!results[p])
+            all_connected = 0;
+    }
+
+    if (!connected)
+        free(results);
+    free_part_index(&index);
+    return all_connected;
+}
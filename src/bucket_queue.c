@@ -0,0 +1,185 @@
+#include "bucket_queue.h"
+
+// tworzy puste kolejki
+Bucket_queue *create_bucket_queue(int vertices, int parts)
+{
+    Bucket_queue *queue = malloc(sizeof(Bucket_queue));
+    if (!queue)
+    {
+        perror("Blad alokacji pamieci dla kolejki frontow");
+        exit(EXIT_FAILURE);
+    }
+
+    queue->parts = parts;
+    queue->entry_count = 0;
+    queue->entry_capacity = vertices > 16 ? vertices : 16;
+    queue->free_entry = -1;
+    queue->entries = malloc(queue->entry_capacity * sizeof(Bucket_entry));
+    queue->vertex_first = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+    queue->buckets = calloc(parts > 0 ? parts : 1, sizeof(int *));
+    queue->bucket_capacity = calloc(parts > 0 ? parts : 1, sizeof(int));
+    queue->max_key = calloc(parts > 0 ? parts : 1, sizeof(int));
+    queue->sizes = calloc(parts > 0 ? parts : 1, sizeof(int));
+    if (!queue->entries || !queue->vertex_first || !queue->buckets || !queue->bucket_capacity ||
+        !queue->max_key || !queue->sizes)
+    {
+        perror("Blad alokacji pamieci dla kolejki frontow");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int v = 0; v < vertices; v++)
+    {
+        queue->vertex_first[v] = -1;
+    }
+    return queue;
+}
+
+// zwalnia kolejki
+void free_bucket_queue(Bucket_queue *queue)
+{
+    if (!queue)
+        return;
+
+    for (int p = 0; p < queue->parts; p++)
+    {
+        free(queue->buckets[p]);
+    }
+    free(queue->entries);
+    free(queue->vertex_first);
+    free(queue->buckets);
+    free(queue->bucket_capacity);
+    free(queue->max_key);
+    free(queue->sizes);
+    free(queue);
+}
+
+// wstawia pozycje na poczatek kubelka o jej kluczu
+static void link_entry(Bucket_queue *queue, int index)
+{
+    Bucket_entry *entry = &queue->entries[index];
+    int part = entry->part;
+
+    // kubelki czesci rosna razem z najwiekszym kluczem
+    if (entry->key >= queue->bucket_capacity[part])
+    {
+        int capacity = queue->bucket_capacity[part] > 0 ? queue->bucket_capacity[part] * 2 : 8;
+        while (capacity <= entry->key)
+            capacity *= 2;
+        int *buckets = realloc(queue->buckets[part], capacity * sizeof(int));
+        if (!buckets)
+        {
+            perror("Blad alokacji pamieci dla kolejki frontow");
+            exit(EXIT_FAILURE);
+        }
+        for (int k = queue->bucket_capacity[part]; k < capacity; k++)
+        {
+            buckets[k] = -1;
+        }
+        queue->buckets[part] = buckets;
+        queue->bucket_capacity[part] = capacity;
+    }
+
+    int *head = &queue->buckets[part][entry->key];
+    entry->prev = -1;
+    entry->next = *head;
+    if (*head != -1)
+        queue->entries[*head].prev = index;
+    *head = index;
+
+    if (entry->key > queue->max_key[part])
+        queue->max_key[part] = entry->key;
+}
+
+// wyjmuje pozycje z jej kubelka
+static void unlink_entry(Bucket_queue *queue, int index)
+{
+    Bucket_entry *entry = &queue->entries[index];
+    if (entry->prev != -1)
+        queue->entries[entry->prev].next = entry->next;
+    else
+        queue->buckets[entry->part][entry->key] = entry->next;
+    if (entry->next != -1)
+        queue->entries[entry->next].prev = entry->prev;
+}
+
+// zwieksza klucz wierzcholka we froncie czesci
+void bucket_queue_increment(Bucket_queue *queue, int part, int vertex)
+{
+    // wierzcholek sasiaduje z kilkoma czesciami, wiec lista jego pozycji jest krotka
+    for (int index = queue->vertex_first[vertex]; index != -1; index = queue->entries[index].vertex_next)
+    {
+        if (queue->entries[index].part == part)
+        {
+            unlink_entry(queue, index);
+            queue->entries[index].key++;
+            link_entry(queue, index);
+            return;
+        }
+    }
+
+    // nowa pozycja z listy wolnych albo z konca puli
+    int index = queue->free_entry;
+    if (index != -1)
+    {
+        queue->free_entry = queue->entries[index].next;
+    }
+    else
+    {
+        if (queue->entry_count >= queue->entry_capacity)
+        {
+            queue->entry_capacity *= 2;
+            Bucket_entry *entries = realloc(queue->entries, queue->entry_capacity * sizeof(Bucket_entry));
+            if (!entries)
+            {
+                perror("Blad alokacji pamieci dla kolejki frontow");
+                exit(EXIT_FAILURE);
+            }
+            queue->entries = entries;
+        }
+        index = queue->entry_count++;
+    }
+
+    Bucket_entry *entry = &queue->entries[index];
+    entry->vertex = vertex;
+    entry->part = part;
+    entry->key = 1;
+    entry->vertex_next = queue->vertex_first[vertex];
+    queue->vertex_first[vertex] = index;
+    queue->sizes[part]++;
+    link_entry(queue, index);
+}
+
+// zdejmuje wierzcholek o najwiekszym kluczu
+int bucket_queue_pop(Bucket_queue *queue, int part)
+{
+    if (queue->sizes[part] == 0)
+        return -1;
+
+    // najwiekszy klucz tylko maleje przy zdejmowaniu, wiec przeszukanie w dol jest zamortyzowane
+    int *buckets = queue->buckets[part];
+    while (buckets[queue->max_key[part]] == -1)
+    {
+        queue->max_key[part]--;
+    }
+    int vertex = queue->entries[buckets[queue->max_key[part]]].vertex;
+
+    // przypisany wierzcholek znika ze wszystkich frontow
+    bucket_queue_remove(queue, vertex);
+    return vertex;
+}
+
+// usuwa wierzcholek ze wszystkich frontow
+void bucket_queue_remove(Bucket_queue *queue, int vertex)
+{
+    int index = queue->vertex_first[vertex];
+    while (index != -1)
+    {
+        int next = queue->entries[index].vertex_next;
+        unlink_entry(queue, index);
+        queue->sizes[queue->entries[index].part]--;
+        queue->entries[index].next = queue->free_entry;
+        queue->free_entry = index;
+        index = next;
+    }
+    queue->vertex_first[vertex] = -1;
+}
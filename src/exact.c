@@ -0,0 +1,299 @@
+#include "exact.h"
+
+// stan przeszukiwania, wierzcholki sa numerowane pozycjami w kolejnosci przypisywania
+typedef struct
+{
+    int n;                                  // liczba wierzcholkow
+    int parts;                              // liczba czesci
+    int min_size;                           // najmniejszy dopuszczalny rozmiar czesci
+    int max_size;                           // najwiekszy dopuszczalny rozmiar czesci
+    int order[EXACT_MAX_VERTICES];          // wierzcholek na danej pozycji
+    uint64_t adjacency[EXACT_MAX_VERTICES]; // sasiedzi pozycji jako zbior pozycji
+    int pinned[EXACT_MAX_VERTICES];         // czesc przypietej pozycji (-1 = wolna)
+    int pinned_labels[EXACT_MAX_VERTICES];  // czesci z przypietymi wierzcholkami
+    int pinned_label_count;
+    int free_labels[EXACT_MAX_VERTICES];    // czesci bez przypiec, zamienne miedzy soba
+    int free_label_count;
+    uint64_t masks[EXACT_MAX_VERTICES];     // pozycje w kazdej czesci
+    int sizes[EXACT_MAX_VERTICES];          // rozmiary czesci
+    int assignment[EXACT_MAX_VERTICES];     // czesc kazdej pozycji
+    int best_assignment[EXACT_MAX_VERTICES];
+    int best_cut;
+    long nodes;
+    int aborted;
+} Exact_search;
+
+// pozycje 0..depth-1 (juz przypisane)
+static inline uint64_t prefix_mask(int depth)
+{
+    return depth >= 64 ? ~(uint64_t)0 : (((uint64_t)1 << depth) - 1);
+}
+
+// sprawdza czy czesc moze byc jeszcze spojna - kazda jej skladowa poza jedyna
+// musi miec sasiada wsrod nieprzypisanych pozycji, przez ktorego moze sie polaczyc z reszta
+static int can_stay_connected(const Exact_search *search, uint64_t mask, uint64_t unassigned)
+{
+    uint64_t rest = mask;
+    int components = 0;
+    int closed = 0;
+    while (rest)
+    {
+        uint64_t component = rest & (~rest + 1);
+        uint64_t frontier = component;
+        uint64_t reach = 0;
+        while (frontier)
+        {
+            uint64_t next = 0;
+            for (uint64_t bits = frontier; bits; bits &= bits - 1)
+            {
+                next |= search->adjacency[__builtin_ctzll(bits)];
+            }
+            reach |= next;
+            frontier = next & mask & ~component;
+            component |= frontier;
+        }
+        rest &= ~component;
+        components++;
+        if (!(reach & unassigned))
+            closed = 1;
+    }
+    return components <= 1 || !closed;
+}
+
+// dolne ograniczenie przyrostu ciecia: krawedz nieprzypisanej pozycji do przypisanego sasiada
+// jest przecieta, chyba ze pozycja trafi do jego czesci, wiec liczymy najlepsza czesc dla kazdej pozycji
+// (pelna czesc juz nikogo nie przyjmie, wiec jej krawedzie sa przeciete na pewno)
+static int unavoidable_cut(const Exact_search *search, int depth)
+{
+    uint64_t assigned = prefix_mask(depth);
+    int bound = 0;
+    for (int u = depth; u < search->n; u++)
+    {
+        uint64_t touching = search->adjacency[u] & assigned;
+        if (!touching)
+            continue;
+        int total = __builtin_popcountll(touching);
+        int kept = 0;
+        if (search->pinned[u] >= 0)
+        {
+            kept = __builtin_popcountll(touching & search->masks[search->pinned[u]]);
+        }
+        else
+        {
+            for (int p = 0; p < search->parts; p++)
+            {
+                if (search->sizes[p] >= search->max_size)
+                    continue;
+                int inside = __builtin_popcountll(touching & search->masks[p]);
+                if (inside > kept)
+                    kept = inside;
+            }
+        }
+        bound += total - kept;
+    }
+    return bound;
+}
+
+// sprawdza czy pozostale pozycje wystarcza, zeby kazda czesc osiagnela minimalny rozmiar
+static int sizes_feasible(const Exact_search *search, int depth)
+{
+    int missing = 0;
+    for (int p = 0; p < search->parts; p++)
+    {
+        if (search->sizes[p] < search->min_size)
+            missing += search->min_size - search->sizes[p];
+    }
+    return missing <= search->n - depth;
+}
+
+// przypisuje pozycje depth kolejno do dopuszczalnych czesci
+static void branch(Exact_search *search, int depth, int cut, int used_free)
+{
+    if (search->aborted)
+        return;
+    if (++search->nodes > EXACT_NODE_LIMIT)
+    {
+        search->aborted = 1;
+        return;
+    }
+
+    if (depth == search->n)
+    {
+        search->best_cut = cut;
+        for (int i = 0; i < search->n; i++)
+        {
+            search->best_assignment[i] = search->assignment[i];
+        }
+        return;
+    }
+
+    // kandydaci: czesc przypieta albo czesci z przypieciami, uzyte czesci wolne i jedna nowa
+    int candidates[EXACT_MAX_VERTICES];
+    int count = 0;
+    if (search->pinned[depth] >= 0)
+    {
+        candidates[count++] = search->pinned[depth];
+    }
+    else
+    {
+        for (int i = 0; i < search->pinned_label_count; i++)
+            candidates[count++] = search->pinned_labels[i];
+        for (int i = 0; i < used_free && i < search->free_label_count; i++)
+            candidates[count++] = search->free_labels[i];
+        if (used_free < search->free_label_count)
+            candidates[count++] = search->free_labels[used_free];
+    }
+
+    // najpierw czesci z najwieksza liczba przypisanych sasiadow (najmniejszy przyrost ciecia)
+    uint64_t touching = search->adjacency[depth] & prefix_mask(depth);
+    int gains[EXACT_MAX_VERTICES];
+    for (int i = 0; i < count; i++)
+    {
+        int part = candidates[i];
+        int gain = __builtin_popcountll(touching & search->masks[part]);
+        int j = i;
+        while (j > 0 && gains[j - 1] < gain)
+        {
+            candidates[j] = candidates[j - 1];
+            gains[j] = gains[j - 1];
+            j--;
+        }
+        candidates[j] = part;
+        gains[j] = gain;
+    }
+
+    int total = __builtin_popcountll(touching);
+    uint64_t bit = (uint64_t)1 << depth;
+    uint64_t unassigned = ~prefix_mask(depth + 1);
+    if (search->n < 64)
+        unassigned &= prefix_mask(search->n);
+
+    for (int i = 0; i < count; i++)
+    {
+        int part = candidates[i];
+        int new_cut = cut + total - gains[i];
+        if (new_cut >= search->best_cut || search->sizes[part] >= search->max_size)
+            continue;
+
+        search->masks[part] |= bit;
+        search->sizes[part]++;
+        search->assignment[depth] = part;
+        int new_used = used_free;
+        if (used_free < search->free_label_count && part == search->free_labels[used_free])
+            new_used++;
+
+        int feasible = sizes_feasible(search, depth + 1) &&
+                       new_cut + unavoidable_cut(search, depth + 1) < search->best_cut;
+
+        // pozycja depth przestala byc wolna, wiec mogly sie zamknac tylko skladowe czesci z jej sasiadami
+        for (int p = 0; feasible && p < search->parts; p++)
+        {
+            if ((p == part || (search->adjacency[depth] & search->masks[p])) &&
+                !can_stay_connected(search, search->masks[p], unassigned))
+                feasible = 0;
+        }
+
+        if (feasible)
+            branch(search, depth + 1, new_cut, new_used);
+
+        search->masks[part] &= ~bit;
+        search->sizes[part]--;
+    }
+}
+
+// dokladny podzial metoda podzialu i ograniczen
+Exact_result exact_partition(Graph *graph, int parts, Partition_data *partition_data, float accuracy)
+{
+    Exact_result result = {0, -1, 0};
+    int n = graph->vertices;
+    if (n > EXACT_MAX_VERTICES || parts <= 0 || parts > n)
+        return result;
+
+    Exact_search *search = calloc(1, sizeof(Exact_search));
+    int *position = malloc(n * sizeof(int));
+    if (!search || !position)
+    {
+        perror("Blad alokacji pamieci dla rozwiazania dokladnego");
+        exit(EXIT_FAILURE);
+    }
+
+    assign_min_max_count(graph, parts, accuracy);
+    search->n = n;
+    search->parts = parts;
+    search->min_size = graph->min_count > 1 ? graph->min_count : 1;
+    search->max_size = graph->max_count;
+    search->best_cut = graph->edges + 1;
+
+    // kolejnosc BFS od wierzcholka najmniejszego stopnia - sasiedzi sa przypisywani blisko siebie,
+    // wiec ciecie i ograniczenie rosna wczesnie; kolejne skladowe doklejamy na koncu
+    for (int v = 0; v < n; v++)
+        position[v] = -1;
+    int placed = 0;
+    while (placed < n)
+    {
+        int start = -1;
+        for (int v = 0; v < n; v++)
+        {
+            if (position[v] == -1 &&
+                (start == -1 || graph->nodes[v].neighbor_count < graph->nodes[start].neighbor_count))
+                start = v;
+        }
+        int head = placed;
+        position[start] = placed;
+        search->order[placed++] = start;
+        while (head < placed)
+        {
+            const Node *node = &graph->nodes[search->order[head++]];
+            for (int j = 0; j < node->neighbor_count; j++)
+            {
+                int neighbor = node->neighbors[j];
+                if (position[neighbor] == -1)
+                {
+                    position[neighbor] = placed;
+                    search->order[placed++] = neighbor;
+                }
+            }
+        }
+    }
+
+    int label_pinned[EXACT_MAX_VERTICES] = {0};
+    for (int i = 0; i < n; i++)
+    {
+        int vertex = search->order[i];
+        const Node *node = &graph->nodes[vertex];
+        for (int j = 0; j < node->neighbor_count; j++)
+        {
+            search->adjacency[i] |= (uint64_t)1 << position[node->neighbors[j]];
+        }
+        search->pinned[i] = is_pinned(graph, vertex) ? graph->pinned[vertex] : -1;
+        if (search->pinned[i] >= 0)
+            label_pinned[search->pinned[i]] = 1;
+    }
+    for (int p = 0; p < parts; p++)
+    {
+        if (label_pinned[p])
+            search->pinned_labels[search->pinned_label_count++] = p;
+        else
+            search->free_labels[search->free_label_count++] = p;
+    }
+
+    if (search->min_size <= search->max_size)
+        branch(search, 0, 0, 0);
+
+    result.nodes = search->nodes;
+    if (!search->aborted && search->best_cut <= graph->edges)
+    {
+        result.status = 1;
+        result.cut = search->best_cut;
+        assing_parts(graph, parts);
+        for (int i = 0; i < n; i++)
+        {
+            set_part_id(graph, search->order[i], search->best_assignment[i]);
+        }
+        rebuild_partition_data(partition_data, graph);
+    }
+
+    free(search);
+    free(position);
+    return result;
+}
@@ -163,6 +163,36 @@ void add_neighbor(Node *node, int neighbor)
     node->neighbors[node->neighbor_count++] = neighbor;
 }
 
+// odczytuje wspolrzedne wierzcholkow z drugiej i trzeciej linii csrrg
+// wierzcholek i lezy w kolumnie line2[i] i w wierszu r, dla ktorego line3[r] <= i < line3[r + 1]
+// przy niespojnych wskaznikach wierszy graf zostaje bez wspolrzednych
+static void extract_grid_coordinates(Graph *graph, const ParsedData *data)
+{
+    if (data->line3_count < 2 || data->line3[0] != 0 || data->line3[data->line3_count - 1] != graph->vertices)
+        return;
+    for (int r = 0; r + 1 < data->line3_count; r++)
+    {
+        if (data->line3[r] > data->line3[r + 1])
+            return;
+    }
+
+    graph->coord_rows = malloc((graph->vertices > 0 ? graph->vertices : 1) * sizeof(int));
+    graph->coord_cols = malloc((graph->vertices > 0 ? graph->vertices : 1) * sizeof(int));
+    if (!graph->coord_rows || !graph->coord_cols)
+    {
+        perror("brak pamieci na wspolrzedne wierzcholkow");
+        exit(EXIT_FAILURE);
+    }
+    for (int r = 0; r + 1 < data->line3_count; r++)
+    {
+        for (int i = data->line3[r]; i < data->line3[r + 1]; i++)
+        {
+            graph->coord_rows[i] = r;
+            graph->coord_cols[i] = data->line2[i];
+        }
+    }
+}
+
 // wczytuje graf z pliku tekstowego
 void load_graph(const char *filename, Graph *graph, ParsedData *data)
 {
@@ -378,4 +408,73 @@ void load_graph(const char *filename, Graph *graph, ParsedData *data)
             }
         }
     }
-}
\ No newline at end of file
+
+    // polozenie wierzcholkow w siatce dla podzialu geometrycznego
+    extract_grid_coordinates(graph, data);
+}
+// wczytuje plik przypiec wierzcholkow do czesci
+int load_pin_file(const char *filename, Graph *graph)
+{
+    FILE *file = fopen(filename, "r");
+    if (file == NULL)
+    {
+        perror("nie mozna otworzyc pliku przypiec");
+        exit(EXIT_FAILURE);
+    }
+
+    // przypiecia sa osobna tablica, -1 oznacza wierzcholek wolny
+    if (graph->pinned == NULL)
+    {
+        graph->pinned = malloc(graph->vertices * sizeof(int));
+        if (graph->pinned == NULL)
+        {
+            perror("brak pamieci na przypiecia");
+            fclose(file);
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < graph->vertices; i++)
+        {
+            graph->pinned[i] = -1;
+        }
+    }
+
+    char line[256];
+    int line_number = 0;
+    int pinned_count = 0;
+    while (fgets(line, sizeof(line), file))
+    {
+        line_number++;
+
+        // separatory zamieniamy na spacje, komentarze i puste linie pomijamy
+        for (char *c = line; *c; c++)
+        {
+            if (*c == ';' || *c == ',')
+                *c = ' ';
+        }
+        char *start = line + strspn(line, " \t\r\n");
+        if (*start == '\0' || *start == '#')
+            continue;
+
+        int vertex, part;
+        if (sscanf(start, "%d %d", &vertex, &part) != 2)
+        {
+            fprintf(stderr, "bledna linia %d w pliku przypiec\n", line_number);
+            fclose(file);
+            exit(EXIT_FAILURE);
+        }
+        if (vertex < 0 || vertex >= graph->vertices || part < 0 || part >= graph->parts)
+        {
+            fprintf(stderr, "linia %d pliku przypiec: wierzcholek %d lub czesc %d poza zakresem\n",
+                    line_number, vertex, part);
+            fclose(file);
+            exit(EXIT_FAILURE);
+        }
+
+        if (graph->pinned[vertex] < 0)
+            pinned_count++;
+        graph->pinned[vertex] = part;
+    }
+
+    fclose(file);
+    return pinned_count;
+}
@@ -1,18 +1,7 @@
 #include "file_writer.h"
 
-// sprawdza czy wierzcholek nalezy do danej czesci grafu
-int is_in_partition(const Partition_data *partition_data, int part_id, int vertex) {
-    // przejdz po wszystkich wierzcholkach w czesci
-    for (int i = 0; i < partition_data->parts[part_id].part_vertex_count; i++) {
-        if (partition_data->parts[part_id].part_vertexes[i] == vertex) {
-            return 1;
-        }
-    }
-    return 0;
-}
-
 // znajduje sasiadow wierzcholka w tej samej czesci grafu
-void get_partition_neighbors(const Graph *graph, const Partition_data *partition_data, int part_id, int vertex, int *neighbors, int *count) {
+void get_partition_neighbors(const Graph *graph, int part_id, int vertex, int *neighbors, int *count) {
     *count = 0;
     
     // sprawdz wszystkich sasiadow wierzcholka
@@ -20,16 +9,40 @@ void get_partition_neighbors(const Graph *graph, const Partition_data *partition
         int neighbor = graph->nodes[vertex].neighbors[i];
         
         // jesli sasiad jest w tej samej czesci to go dodaj
-        if (is_in_partition(partition_data, part_id, neighbor)) {
+        if (is_in_partition(graph, part_id, neighbor)) {
             neighbors[*count] = neighbor;
             (*count)++;
         }
     }
 }
 
-// pomocnicza funkcja do sortowania liczb
-int compare_ints(const void *a, const void *b) {
-    return (*(int*)a - *(int*)b);
+// pobiera sasiedztwo wszystkich czesci, przy bledzie zwalnia juz pobrane
+static Part_neighbors *collect_part_neighbors(const Graph *graph, const Partition_data *partition_data, int parts) {
+    Part_neighbors *all_parts = calloc(parts, sizeof(Part_neighbors));
+    if (!all_parts) {
+        perror("blad alokacji pamieci");
+        return NULL;
+    }
+
+    for (int part = 0; part < parts; part++) {
+        if (!get_part_neighbors(graph, partition_data, part, &all_parts[part])) {
+            perror("blad przy pobieraniu sasiadow z czesci");
+            for (int i = 0; i < part; i++) {
+                free_part_neighbors(&all_parts[i]);
+            }
+            free(all_parts);
+            return NULL;
+        }
+    }
+    return all_parts;
+}
+
+// zwalnia sasiedztwo wszystkich czesci
+static void release_part_neighbors(Part_neighbors *all_parts, int parts) {
+    for (int part = 0; part < parts; part++) {
+        free_part_neighbors(&all_parts[part]);
+    }
+    free(all_parts);
 }
 
 // zapisuje graf w formacie tekstowym
@@ -61,91 +74,52 @@ void write_text(const char *filename, const ParsedData *data, const Partition_da
     }
     fprintf(file, "\n");
 
-    // zaalokuj pamiec na dane o sasiadach
-    int *sizes = malloc(parts * sizeof(int));
-    int ***all_part_neighbors = malloc(parts * sizeof(int**));
-    
-    if (!sizes || !all_part_neighbors) {
-        perror("blad alokacji pamieci");
+    // pobierz sasiedztwo czesci w ukladzie CSR
+    Part_neighbors *all_parts = collect_part_neighbors(graph, partition_data, parts);
+    if (!all_parts) {
+        fclose(file);
         return;
     }
 
     for (int part = 0; part < parts; part++) {
-        all_part_neighbors[part] = get_part_neighbors(graph, partition_data, part, &sizes[part]);
-        if (!all_part_neighbors[part]) {
-            perror("blad przy pobieraniu sasiadow z czesci");
-            goto cleanup;
-        }
-    }
+        const Part_neighbors *current = &all_parts[part];
+        for (int i = 0; i < current->size; i++) {
+            fprintf(file, "%d", current->vertices[i]);
 
-    for (int part = 0; part < parts; part++) {
-        for (int i = 0; i < sizes[part]; i++) {
-            fprintf(file, "%d", all_part_neighbors[part][i][0]);
-            
-            int j = 1;
-            while (all_part_neighbors[part][i][j] != -1) {
-                if (j == 1) {
-                    fprintf(file, ";");
-                } else {
-                    fprintf(file, ",");
-                }
-                fprintf(file, "%d", all_part_neighbors[part][i][j]);
-                j++;
+            for (int j = current->offsets[i]; j < current->offsets[i + 1]; j++) {
+                fprintf(file, j == current->offsets[i] ? ";" : ",");
+                fprintf(file, "%d", current->neighbors[j]);
             }
 
-            if (!(part == parts - 1 && i == sizes[part] - 1)) {
+            if (!(part == parts - 1 && i == current->size - 1)) {
                 fprintf(file, ";");
             }
         }
     }
     fprintf(file, "\n");
 
+    // pozycje grup: kazdy wierzcholek zajmuje sam siebie i swoich sasiadow
     fprintf(file, "0");
     int last_pos = 0;
 
-    for (int i = 0; i < sizes[0]; i++) {
-        int neighbor_count = 0;
-        int j = 1;
-        while (all_part_neighbors[0][i][j] != -1) {
-            neighbor_count++;
-            j++;
-        }
-        last_pos += (neighbor_count + 1);
+    for (int i = 0; i < all_parts[0].size; i++) {
+        last_pos += all_parts[0].offsets[i + 1] - all_parts[0].offsets[i] + 1;
         fprintf(file, ";%d", last_pos);
     }
     fprintf(file, "\n");
 
     for (int part = 1; part < parts; part++) {
+        const Part_neighbors *current = &all_parts[part];
         fprintf(file, "%d", last_pos);
-        int pos = last_pos;
-
-        for (int i = 0; i < sizes[part]; i++) {
-            int neighbor_count = 0;
-            int j = 1;
-            while (all_part_neighbors[part][i][j] != -1) {
-                neighbor_count++;
-                j++;
-            }
-            pos += (neighbor_count + 1);
-            fprintf(file, ";%d", pos);
+
+        for (int i = 0; i < current->size; i++) {
+            last_pos += current->offsets[i + 1] - current->offsets[i] + 1;
+            fprintf(file, ";%d", last_pos);
         }
-        last_pos = pos;
         fprintf(file, "\n");
     }
 
-cleanup:
-    if (all_part_neighbors) {
-        for (int part = 0; part < parts; part++) {
-            if (all_part_neighbors[part]) {
-                for (int i = 0; i < sizes[part]; i++) {
-                    free(all_part_neighbors[part][i]);
-                }
-                free(all_part_neighbors[part]);
-            }
-        }
-        free(all_part_neighbors);
-    }
-    free(sizes);
+    release_part_neighbors(all_parts, parts);
     fclose(file);
 }
 
@@ -187,31 +161,20 @@ void write_binary(const char *filename, const ParsedData *data, const Partition_
     }
     fwrite(&separator, sizeof(uint64_t), 1, file);
 
-    int *sizes = malloc(parts * sizeof(int));
-    int ***all_part_neighbors = malloc(parts * sizeof(int**));
-    
-    if (!sizes || !all_part_neighbors) {
-        perror("blad alokacji pamieci");
+    // pobierz sasiedztwo czesci w ukladzie CSR
+    Part_neighbors *all_parts = collect_part_neighbors(graph, partition_data, parts);
+    if (!all_parts) {
         fclose(file);
         return;
     }
 
     for (int part = 0; part < parts; part++) {
-        all_part_neighbors[part] = get_part_neighbors(graph, partition_data, part, &sizes[part]);
-        if (!all_part_neighbors[part]) {
-            perror("blad przy pobieraniu sasiadow z czesci");
-            goto cleanup;
-        }
-    }
+        const Part_neighbors *current = &all_parts[part];
+        for (int i = 0; i < current->size; i++) {
+            encode_vbyte(file, current->vertices[i]);
 
-    for (int part = 0; part < parts; part++) {
-        for (int i = 0; i < sizes[part]; i++) {
-            encode_vbyte(file, all_part_neighbors[part][i][0]);
-            
-            int j = 1;
-            while (all_part_neighbors[part][i][j] != -1) {
-                encode_vbyte(file, all_part_neighbors[part][i][j]);
-                j++;
+            for (int j = current->offsets[i]; j < current->offsets[i + 1]; j++) {
+                encode_vbyte(file, current->neighbors[j]);
             }
         }
     }
@@ -220,51 +183,63 @@ void write_binary(const char *filename, const ParsedData *data, const Partition_
     encode_vbyte(file, 0);
     int last_pos = 0;
 
-    for (int i = 0; i < sizes[0]; i++) {
-        int neighbor_count = 0;
-        int j = 1;
-        while (all_part_neighbors[0][i][j] != -1) {
-            neighbor_count++;
-            j++;
-        }
-        last_pos += (neighbor_count + 1);
+    for (int i = 0; i < all_parts[0].size; i++) {
+        last_pos += all_parts[0].offsets[i + 1] - all_parts[0].offsets[i] + 1;
         encode_vbyte(file, last_pos);
     }
     fwrite(&separator, sizeof(uint64_t), 1, file);
 
     for (int part = 1; part < parts; part++) {
+        const Part_neighbors *current = &all_parts[part];
         encode_vbyte(file, last_pos);
-        int pos = last_pos;
-
-        for (int i = 0; i < sizes[part]; i++) {
-            int neighbor_count = 0;
-            int j = 1;
-            while (all_part_neighbors[part][i][j] != -1) {
-                neighbor_count++;
-                j++;
-            }
-            pos += (neighbor_count + 1);
-            encode_vbyte(file, pos);
+
+        for (int i = 0; i < current->size; i++) {
+            last_pos += current->offsets[i + 1] - current->offsets[i] + 1;
+            encode_vbyte(file, last_pos);
         }
-        last_pos = pos;
         if (part < parts - 1) {
             fwrite(&separator, sizeof(uint64_t), 1, file);
         }
     }
 
-cleanup:
-    // Free allocated memory
-    if (all_part_neighbors) {
-        for (int part = 0; part < parts; part++) {
-            if (all_part_neighbors[part]) {
-                for (int i = 0; i < sizes[part]; i++) {
-                    free(all_part_neighbors[part][i]);
-                }
-                free(all_part_neighbors[part]);
-            }
+    release_part_neighbors(all_parts, parts);
+    fclose(file);
+}
+
+// zapisuje podgrafy czesci z numeracja lokalna w formacie binarnym
+void write_local_binary(const char *filename, const Subgraph_set *set) {
+    FILE *file = fopen(filename, "wb");
+    if (!file) {
+        perror("nie mozna otworzyc pliku binarnego do zapisu");
+        return;
+    }
+
+    const uint64_t separator = 0xDEADBEEFCAFEBABE;
+
+    encode_vbyte(file, set->parts);
+    fwrite(&separator, sizeof(uint64_t), 1, file);
+
+    for (int part = 0; part < set->parts; part++) {
+        const Part_subgraph *subgraph = &set->subgraphs[part];
+        encode_vbyte(file, subgraph->vertices);
+        encode_vbyte(file, subgraph->offsets[subgraph->vertices]);
+
+        // numery globalne sa rosnace, wiec zapisujemy roznice
+        int previous = 0;
+        for (int i = 0; i < subgraph->vertices; i++) {
+            encode_vbyte(file, subgraph->local_to_global[i] - previous);
+            previous = subgraph->local_to_global[i];
+        }
+
+        // stopnie i lokalni sasiedzi
+        for (int i = 0; i < subgraph->vertices; i++) {
+            encode_vbyte(file, subgraph->offsets[i + 1] - subgraph->offsets[i]);
         }
-        free(all_part_neighbors);
+        for (int j = 0; j < subgraph->offsets[subgraph->vertices]; j++) {
+            encode_vbyte(file, subgraph->neighbors[j]);
+        }
+        fwrite(&separator, sizeof(uint64_t), 1, file);
     }
-    free(sizes);
+
     fclose(file);
-}
\ No newline at end of file
+}
@@ -34,7 +34,7 @@ void *thread_find_best_move(void *arg)
             for (int p = 0; p < context->graph->parts; p++)
             {
                 // omijamy partie w ktorej juz jest wierzcholek
-                if (p != context->graph->nodes[i].part_id)
+                if (p != get_part_id(context->graph, i))
                 {
                     // sprawdzamy zysk
                     int gain = calculate_gain(context, i, p);
@@ -59,27 +59,52 @@ int find_best_move(FM_Context *context, bool *is_boundary)
     int best_vertex = -1;
     int best_gain = 0;
     int best_target_part = -1;
+    int best_pair_weight = 0;
+    Quotient_graph *quotient = context->graph->quotient;
+
+    // z ukladem SELL liczymy naraz stopnie wewnetrzne wszystkich wierzcholkow
+    int *internal = context->internal_degrees;
+    if (internal)
+        sell_internal_degrees(context->graph, context->graph->sell, internal);
 
     // sprawdzamy po kolei wszystkie wierzcholki
     for (int i = 0; i < context->graph->vertices; i++)
     {
+        // zysk nie przekroczy liczby sasiadow spoza partii minus sasiadow w partii
+        if (internal && context->graph->nodes[i].neighbor_count - internal[i] <= internal[i])
+            continue;
+
         // tylko graniczne, niezablokowane i nie zabanowane
         if (is_boundary[i] && !context->locked[i] && !context->unmovable[i])
         {
-            // sprawdzamy wszystkie mozliwe partie docelowe
-            for (int p = 0; p < context->graph->parts; p++)
+            int current_part = get_part_id(context->graph, i);
+
+            // zysk moze dac tylko partia sasiadujaca z obecna, graf ilorazowy zna je wszystkie
+            int use_quotient = quotient && current_part >= 0;
+            int target_count = use_quotient ? quotient->degree[current_part] : context->graph->parts;
+            for (int t = 0; t < target_count; t++)
             {
+                int p = use_quotient ? quotient->adjacent[current_part][t] : t;
+
                 // omijamy partie w ktorej wierzcholek juz jest
-                if (p != context->graph->nodes[i].part_id)
+                if (p == current_part)
+                    continue;
+
+                int gain = calculate_gain(context, i, p);
+                if (gain <= 0)
+                    continue;
+
+                // przy rownym zysku pierwszenstwo ma para czesci z wieksza liczba przeciec
+                int pair_weight = use_quotient ? quotient->weights[current_part][t] : 0;
+                int better = gain > best_gain || (gain == best_gain && pair_weight > best_pair_weight);
+
+                // ruch musi byc zyskowny i nie psuc spojnosci
+                if (better && is_move_valid_with_integrity(context, i, p))
                 {
-                    int gain = calculate_gain(context, i, p);
-                    // ruch musi byc zyskowny i nie psuc spojnosci
-                    if (gain > 0 && gain > best_gain && is_move_valid_with_integrity(context, i, p))
-                    {
-                        best_gain = gain;
-                        best_vertex = i;
-                        best_target_part = p;
-                    }
+                    best_gain = gain;
+                    best_vertex = i;
+                    best_target_part = p;
+                    best_pair_weight = pair_weight;
                 }
             }
         }
@@ -98,74 +123,21 @@ int find_best_move(FM_Context *context, bool *is_boundary)
 int is_partition_connected(Graph *graph, int part_id)
 {
     // sprawdzamy parametry
-    if (!graph)
+    if (!graph || part_id < 0 || part_id >= graph->parts)
         return 0;
 
-    // liczymy ile wierzcholkow jest w tej partycji
-    int vertices_in_part = 0;
-    for (int i = 0; i < graph->vertices; i++)
-        if (graph->nodes[i].part_id == part_id)
-            vertices_in_part++;
-
-    // pusta partycja jest ok
-    if (vertices_in_part == 0)
-        return 1;
+    // rozmiar partycji jest utrzymywany w grafie, nie musimy go liczyc
+    int vertices_in_part = graph->part_sizes[part_id];
 
-    // jeden wierzcholek tez jest ok
-    if (vertices_in_part == 1)
+    // pusta partycja i jeden wierzcholek sa ok
+    if (vertices_in_part <= 1)
         return 1;
 
-    // alokujemy pamiec na odwiedzone i kolejke
-    bool *visited = calloc(graph->vertices, sizeof(bool));
-    if (!visited)
-        return 0;
-
-    int *queue = malloc(graph->vertices * sizeof(int));
-    if (!queue)
-    {
-        free(visited);
-        return 0;
-    }
-
-    // szukamy pierwszego wierzcholka w partycji
-    int start_vertex = -1;
-    for (int i = 0; i < graph->vertices; i++)
-    {
-        if (graph->nodes[i].part_id == part_id)
-        {
-            start_vertex = i;
-            break;
-        }
-    }
-
-    // robimy BFS zaczynajac od znalezionego wierzcholka
-    int front = 0, rear = 0;
-    queue[rear++] = start_vertex;
-    visited[start_vertex] = true;
-    int nodes_visited = 1;
-
-    while (front < rear)
-    {
-        int current = queue[front++];
-
-        // sprawdzamy sasiadow obecnego wierzcholka
-        for (int i = 0; i < graph->nodes[current].neighbor_count; i++)
-        {
-            int neighbor = graph->nodes[current].neighbors[i];
-
-            // dodajemy do kolejki tylko sasiadow z tej samej partycji
-            if (graph->nodes[neighbor].part_id == part_id && !visited[neighbor])
-            {
-                visited[neighbor] = true;
-                queue[rear++] = neighbor;
-                nodes_visited++;
-            }
-        }
-    }
-
-    // sprzatamy
-    free(queue);
-    free(visited);
+    // robimy BFS od pierwszego wierzcholka partycji na wspolnym buforze watku
+    Traversal_workspace *workspace = get_traversal_workspace(graph->vertices);
+    begin_traversal(workspace);
+    int start_vertex = find_part_vertex(graph, part_id, -1);
+    int nodes_visited = bfs_within_part(graph, workspace, start_vertex, part_id, -1);
 
     // partycja jest spojna jesli odwiedzilismy wszystkie wierzcholki
     return (nodes_visited == vertices_in_part);
@@ -174,79 +146,42 @@ int is_partition_connected(Graph *graph, int part_id)
 // sprawdza czy partycja pozostanie spojna jesli usuniemy z niej wierzcholek
 int will_remain_connected_if_removed(Graph *graph, int vertex)
 {
-    int current_part = graph->nodes[vertex].part_id;
+    int current_part = get_part_id(graph, vertex);
 
     // liczymy wierzcholki w partycji bez usuwanego
-    int vertices_in_part = 0;
-    for (int i = 0; i < graph->vertices; i++)
-    {
-        if (i != vertex && graph->nodes[i].part_id == current_part)
-            vertices_in_part++;
-    }
+    int vertices_in_part = graph->part_sizes[current_part] - 1;
 
     // jesli zostaje 0 lub 1 wierzcholek, to bedzie spojna
     if (vertices_in_part <= 1)
     {
-        // printf("DEBUG: Moving vertex %d - source partition will have %d vertices - SPOJNOSC OK\n",vertex, vertices_in_part);
         return 1;
     }
 
-    // alokujemy pamiec na BFS
-    bool *visited = calloc(graph->vertices, sizeof(bool));
-    int *queue = malloc(graph->vertices * sizeof(int));
-    if (!visited || !queue)
-    {
-        if (visited)
-            free(visited);
-        if (queue)
-            free(queue);
-        return 0;
-    }
-
-    // szukamy pierwszego wierzcholka w partycji (innego niz usuwany)
+    // startujemy od sasiada z tej samej partycji, zeby nie przegladac calego grafu
     int start_vertex = -1;
-    for (int i = 0; i < graph->vertices; i++)
+    for (int i = 0; i < graph->nodes[vertex].neighbor_count; i++)
     {
-        if (i != vertex && graph->nodes[i].part_id == current_part)
+        int neighbor = graph->nodes[vertex].neighbors[i];
+        if (get_part_id(graph, neighbor) == current_part)
         {
-            start_vertex = i;
+            start_vertex = neighbor;
             break;
         }
     }
 
-    // robimy BFS omijajac usuwany wierzcholek
-    int front = 0, rear = 0;
-    queue[rear++] = start_vertex;
-    visited[start_vertex] = true;
-    int nodes_visited = 1;
-
-    while (front < rear)
+    // wierzcholek bez sasiadow w partycji - szukamy dowolnego innego
+    if (start_vertex == -1)
     {
-        int current = queue[front++];
-
-        for (int i = 0; i < graph->nodes[current].neighbor_count; i++)
-        {
-            int neighbor = graph->nodes[current].neighbors[i];
-
-            // pomijamy usuwany wierzcholek
-            if (neighbor != vertex &&
-                graph->nodes[neighbor].part_id == current_part &&
-                !visited[neighbor])
-            {
-                visited[neighbor] = true;
-                queue[rear++] = neighbor;
-                nodes_visited++;
-            }
-        }
+        start_vertex = find_part_vertex(graph, current_part, vertex);
     }
 
-    // sprawdzamy czy wszystkie wierzcholki sa osiagalne
-    int result = (nodes_visited == vertices_in_part);
-
-    free(visited);
-    free(queue);
+    // robimy BFS omijajac usuwany wierzcholek
+    Traversal_workspace *workspace = get_traversal_workspace(graph->vertices);
+    begin_traversal(workspace);
+    int nodes_visited = bfs_within_part(graph, workspace, start_vertex, current_part, vertex);
 
-    return result;
+    // sprawdzamy czy wszystkie wierzcholki sa osiagalne
+    return (nodes_visited == vertices_in_part);
 }
 
 // weryfikuje spojnosc wszystkich partycji w grafie
@@ -255,51 +190,8 @@ int verify_partition_integrity(Graph *graph)
     if (!graph)
         return 0;
 
-    int all_connected = 1;
-
-    // szukamy wszystkich unikalnych id partycji
-    int *unique_partitions = calloc(graph->vertices, sizeof(int));
-    bool *found = calloc(graph->vertices, sizeof(bool));
-    int unique_count = 0;
-
-    if (!unique_partitions || !found)
-    {
-        free(unique_partitions);
-        free(found);
-        return 0;
-    }
-
-    // zbieramy wszystkie partie
-    for (int i = 0; i < graph->vertices; i++)
-    {
-        int part_id = graph->nodes[i].part_id;
-        if (!found[part_id])
-        {
-            found[part_id] = true;
-            unique_partitions[unique_count++] = part_id;
-        }
-    }
-
-    // wypisujemy status kazdej partycji
-    // printf("\n--- Partition Integrity Verification ---\n");
-    for (int i = 0; i < unique_count; i++)
-    {
-        int part_id = unique_partitions[i];
-        int is_connected = is_partition_connected(graph, part_id);
-        // printf("Partition %d is %s\n", part_id, is_connected ? "connected" : "DISCONNECTED");
-
-        if (!is_connected)
-            all_connected = 0;
-    }
-
-    free(unique_partitions);
-    free(found);
-
-    // podsumowanie
-    // printf("Overall partition integrity: %s\n", all_connected ? "VALID" : "INVALID");
-    // printf("--- End of Verification ---\n");
-
-    return all_connected;
+    // wszystkie partycje sprawdzamy naraz silnikiem BFS
+    return check_all_parts_connected(graph, graph->parts, NULL);
 }
 
 // liczy ile krawedzi przecina granice partycji
@@ -308,6 +200,10 @@ int count_cut_edges(Graph *graph)
     if (!graph)
         return 0;
 
+    // z ukladem SELL liczymy przeciecia jadrem SIMD
+    if (graph->sell)
+        return sell_count_cut_edges(graph, graph->sell);
+
     int cut_edges = 0;
 
     // przechodzimy przez wszystkie krawedzie
@@ -318,7 +214,7 @@ int count_cut_edges(Graph *graph)
             int neighbor = graph->nodes[i].neighbors[j];
 
             // liczymy tylko w jedna strone, zeby nie liczyc podwojnie
-            if (i < neighbor && graph->nodes[i].part_id != graph->nodes[neighbor].part_id)
+            if (i < neighbor && get_part_id(graph, i) != get_part_id(graph, neighbor))
             {
                 cut_edges++;
             }
@@ -350,8 +246,8 @@ void print_final_statistics(Graph *graph)
 
     for (int i = 0; i < graph->vertices; i++)
     {
-        if (graph->nodes[i].part_id >= 0 && graph->nodes[i].part_id < graph->parts)
-            part_sizes[graph->nodes[i].part_id]++;
+        if (get_part_id(graph, i) >= 0 && get_part_id(graph, i) < graph->parts)
+            part_sizes[get_part_id(graph, i)]++;
     }
 
     // wypisujemy rozklad
@@ -391,7 +287,7 @@ void print_partition_stats(FM_Context *context)
         for (int j = 0; j < context->graph->nodes[i].neighbor_count; j++)
         {
             int neighbor = context->graph->nodes[i].neighbors[j];
-            if (context->graph->nodes[i].part_id != context->graph->nodes[neighbor].part_id)
+            if (get_part_id(context->graph, i) != get_part_id(context->graph, neighbor))
             {
                 is_boundary = true;
                 break;
@@ -424,7 +320,7 @@ void analyze_moves(FM_Context *context, bool *is_boundary)
             // dla kazdej mozliwej partycji docelowej
             for (int p = 0; p < context->graph->parts; p++)
             {
-                if (p != context->graph->nodes[i].part_id)
+                if (p != get_part_id(context->graph, i))
                 {
                     total_moves++;
                     int is_valid = is_valid_move(context, i, p);
@@ -440,7 +336,7 @@ void analyze_moves(FM_Context *context, bool *is_boundary)
                         if (gain > 0)
                         {
                             positive_gain_moves++;
-                            // printf("  Vertex %d can move from part %d to part %d with gain %d\n",i, context->graph->nodes[i].part_id, p, gain);
+                            // printf("  Vertex %d can move from part %d to part %d with gain %d\n",i, get_part_id(context->graph, i), p, gain);
                         }
                     }
                 }
@@ -456,6 +352,24 @@ void analyze_moves(FM_Context *context, bool *is_boundary)
     // printf("--- End of Analysis ---\n");
 }
 
+// zwalnia graf ilorazowy jesli FM zbudowal go tylko na swoje potrzeby
+static void release_fm_quotient(Graph *graph, int owns_quotient)
+{
+    if (owns_quotient)
+    {
+        free_quotient_graph(graph->quotient);
+        graph->quotient = NULL;
+    }
+}
+
+// wylacza wypisywanie statystyk FM w biezacym watku (rownolegle proby wypisywalyby je naraz)
+static __thread int fm_quiet = 0;
+
+void set_fm_quiet(int quiet)
+{
+    fm_quiet = quiet;
+}
+
 // glowna funkcja algorytmu FM do optymalizacji ciec krawedzi
 void cut_edges_optimization(Graph *graph, Partition_data *partition_data, int max_iterations)
 {
@@ -466,11 +380,20 @@ void cut_edges_optimization(Graph *graph, Partition_data *partition_data, int ma
         // printf("Warning: max_iterations was set to %d, using default value: %d\n", max_iterations, 100);
     }
 
+    // graf ilorazowy zwykle jest juz zbudowany po region growing, jesli nie to budujemy go na czas FM
+    int owns_quotient = 0;
+    if (!graph->quotient)
+    {
+        graph->quotient = build_quotient_graph(graph);
+        owns_quotient = 1;
+    }
+
     // inicjalizujemy kontekst algorytmu
     FM_Context *context = initialize_fm_context(graph, partition_data, max_iterations);
     if (!context)
     {
         fprintf(stderr, "Failed to initialize FM context\n");
+        release_fm_quotient(graph, owns_quotient);
         return;
     }
 
@@ -480,6 +403,7 @@ void cut_edges_optimization(Graph *graph, Partition_data *partition_data, int ma
     {
         fprintf(stderr, "Failed to allocate memory for boundary vertices\n");
         free_fm_context(context);
+        release_fm_quotient(graph, owns_quotient);
         return;
     }
 
@@ -488,7 +412,8 @@ void cut_edges_optimization(Graph *graph, Partition_data *partition_data, int ma
     context->current_cut = context->initial_cut;
 
     // pokazujemy statystyki przed optymalizacja
-    print_partition_stats(context);
+    if (!fm_quiet)
+        print_partition_stats(context);
 
     // znajdujemy wierzcholki na granicy partycji
     identify_boundary_vertices(context, is_boundary);
@@ -502,6 +427,7 @@ void cut_edges_optimization(Graph *graph, Partition_data *partition_data, int ma
         // printf("No crossing edges to optimize. Exiting.\n");
         free(is_boundary);
         free_fm_context(context);
+        release_fm_quotient(graph, owns_quotient);
         return;
     }
 
@@ -510,6 +436,10 @@ void cut_edges_optimization(Graph *graph, Partition_data *partition_data, int ma
     // glowna petla algorytmu
     for (int iter = 0; iter < max_iterations; iter++)
     {
+        // zadna para czesci nie ma juz przeciec
+        if (graph->quotient->total_cut == 0)
+            break;
+
         // aktualizacja wierzcholkow granicznych
         identify_boundary_vertices(context, is_boundary);
 
@@ -551,7 +481,8 @@ void cut_edges_optimization(Graph *graph, Partition_data *partition_data, int ma
     }
 
     // pokazujemy wyniki
-    print_cut_statistics(context);
+    if (!fm_quiet)
+        print_cut_statistics(context);
 
     // dodatkowe statystyki
     // print_final_statistics(graph);
@@ -563,9 +494,13 @@ void cut_edges_optimization(Graph *graph, Partition_data *partition_data, int ma
         // restore_best_solution(context);
     }
 
+    // ruchy zmienialy tylko tablice przypisan, odswiezamy widok czesci
+    rebuild_partition_data(partition_data, graph);
+
     // zwalniamy pamiec
     free(is_boundary);
     free_fm_context(context);
+    release_fm_quotient(graph, owns_quotient);
 }
 
 // sprawdza czy ruch wierzcholka nie popsuje spojnosci partycji
@@ -578,7 +513,7 @@ int is_move_valid_with_integrity(FM_Context *context, int vertex, int target_par
     }
 
     // zapamietujemy obecna partycje
-    int source_part = context->graph->nodes[vertex].part_id;
+    int source_part = get_part_id(context->graph, vertex);
 
     // sprawdzamy czy po usunieciu wierzcholka partycja zostanie spojna
     if (!will_remain_connected_if_removed(context->graph, vertex))
@@ -593,7 +528,7 @@ int is_move_valid_with_integrity(FM_Context *context, int vertex, int target_par
     for (int i = 0; i < context->graph->nodes[vertex].neighbor_count; i++)
     {
         int neighbor = context->graph->nodes[vertex].neighbors[i];
-        if (context->graph->nodes[neighbor].part_id == target_part)
+        if (get_part_id(context->graph, neighbor) == target_part)
         {
             has_connection = 1;
             break;
@@ -623,13 +558,13 @@ int apply_move_safely(FM_Context *context, int vertex, int target_part)
     }
 
     // zapamietujemy stan poczatkowy
-    int source_part = context->graph->nodes[vertex].part_id;
+    int source_part = get_part_id(context->graph, vertex);
     int gain = calculate_gain(context, vertex, target_part);
 
     // printf("DEBUG: Moving vertex %d from part %d to part %d (gain: %d)\n",vertex, source_part, target_part, gain);
 
     // wykonujemy ruch
-    context->graph->nodes[vertex].part_id = target_part;
+    set_part_id(context->graph, vertex, target_part);
     context->part_sizes[source_part]--;
     context->part_sizes[target_part]++;
 
@@ -639,7 +574,7 @@ int apply_move_safely(FM_Context *context, int vertex, int target_part)
         // printf("CRITICAL ERROR: Move broke overall partition integrity!\n");
 
         // cofamy ruch
-        context->graph->nodes[vertex].part_id = source_part;
+        set_part_id(context->graph, vertex, source_part);
         context->part_sizes[source_part]++;
         context->part_sizes[target_part]--;
         context->unmovable[vertex] = true; // banujemy na przyszlosc
@@ -753,11 +688,31 @@ FM_Context *initialize_fm_context(Graph *graph, Partition_data *partition_data,
     // na razie nie uzywamy best_partition
     context->best_partition = NULL;
 
+    // bufor stopni wewnetrznych tylko gdy graf ma uklad SELL
+    context->internal_degrees = NULL;
+    if (graph->sell)
+    {
+        context->internal_degrees = malloc(graph->vertices * sizeof(int));
+        if (!context->internal_degrees)
+        {
+            fprintf(stderr, "Failed to allocate memory for internal degrees\n");
+            free(context->unmovable);
+            free(context->part_sizes);
+            free(context->target_parts);
+            free(context->gains);
+            free(context->locked);
+            free(context);
+            return NULL;
+        }
+    }
+
     // inicjalizujemy tablice zyskow i docelowych partycji
+    // przypiete wierzcholki sa na stale nieruchome, FM ich nie rozwaza
     for (int i = 0; i < graph->vertices; i++)
     {
         context->gains[i] = 0;
-        context->target_parts[i] = graph->nodes[i].part_id;
+        context->target_parts[i] = get_part_id(graph, i);
+        context->unmovable[i] = is_pinned(graph, i);
     }
 
     return context;
@@ -773,6 +728,7 @@ void free_fm_context(FM_Context *context)
         free(context->gains);
         free(context->target_parts);
         free(context->part_sizes);
+        free(context->internal_degrees);
         free(context);
     }
 }
@@ -780,6 +736,13 @@ void free_fm_context(FM_Context *context)
 // znajduje wierzcholki ktore sa na granicy partycji
 void identify_boundary_vertices(FM_Context *context, bool *is_boundary)
 {
+    // z ukladem SELL wystarczy porownac stopien wewnetrzny ze stopniem
+    if (context->graph->sell)
+    {
+        sell_identify_boundary(context->graph, context->graph->sell, is_boundary);
+        return;
+    }
+
     for (int i = 0; i < context->graph->vertices; i++)
     {
         // na poczatku zakladamy ze nie jest graniczny
@@ -790,7 +753,7 @@ void identify_boundary_vertices(FM_Context *context, bool *is_boundary)
         {
             int neighbor = context->graph->nodes[i].neighbors[j];
             // jesli sasiad jest w innej partycji to wierzcholek jest graniczny
-            if (context->graph->nodes[i].part_id != context->graph->nodes[neighbor].part_id)
+            if (get_part_id(context->graph, i) != get_part_id(context->graph, neighbor))
             {
                 is_boundary[i] = true;
                 break;
@@ -802,6 +765,9 @@ void identify_boundary_vertices(FM_Context *context, bool *is_boundary)
 // liczy poczatkowa liczbe przecietych krawedzi
 int calculate_initial_cut(FM_Context *context)
 {
+    if (context->graph->sell)
+        return sell_count_cut_edges(context->graph, context->graph->sell);
+
     int cut_edges = 0;
 
     // przechodzimy przez wszystkie krawedzie
@@ -813,7 +779,7 @@ int calculate_initial_cut(FM_Context *context)
 
             // liczymy tylko w jedna strone zeby uniknac podwojnego liczenia
             if (i < neighbor &&
-                context->graph->nodes[i].part_id != context->graph->nodes[neighbor].part_id)
+                get_part_id(context->graph, i) != get_part_id(context->graph, neighbor))
             {
                 cut_edges++;
             }
@@ -833,34 +799,12 @@ int calculate_gain(FM_Context *context, int vertex, int target_part)
         return 0;
     }
 
-    int current_part = context->graph->nodes[vertex].part_id;
-    int gain = 0;
-
-    // sprawdzamy wszystkich sasiadow
-    for (int i = 0; i < context->graph->nodes[vertex].neighbor_count; i++)
-    {
-        int neighbor = context->graph->nodes[vertex].neighbors[i];
-        if (neighbor < 0 || neighbor >= context->graph->vertices)
-        {
-            continue;
-        }
-
-        int neighbor_part = context->graph->nodes[neighbor].part_id;
-
-        // sasiad w partycji docelowej - zyskujemy bo krawedz nie bedzie przecieta
-        if (neighbor_part == target_part)
-        {
-            gain++;
-        }
-        // sasiad w obecnej partycji - tracimy bo tworzymy nowe przeciecie
-        else if (neighbor_part == current_part)
-        {
-            gain--;
-        }
-        // sasiedzi w innych partiach nie zmieniaja wyniku
-    }
+    int current_part = get_part_id(context->graph, vertex);
+    Node *node = &context->graph->nodes[vertex];
 
-    return gain;
+    // sasiedzi w partycji docelowej zwiekszaja zysk, sasiedzi w obecnej go zmniejszaja
+    // sasiedzi w innych partiach nie zmieniaja wyniku
+    return gain_kernel(context->graph, node->neighbors, node->neighbor_count, current_part, target_part);
 }
 
 // sprawdza czy mozna przeniesc wierzcholek
@@ -873,7 +817,7 @@ int is_valid_move(FM_Context *context, int vertex, int target_part)
         return 0;
     }
 
-    int current_part = context->graph->nodes[vertex].part_id;
+    int current_part = get_part_id(context->graph, vertex);
 
     // nie przenosimy zabanowanych wierzcholkow
     if (context->unmovable[vertex])
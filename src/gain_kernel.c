@@ -0,0 +1,129 @@
+#include "gain_kernel.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// zamienia numer czesci na wartosc zapisana w tablicy przypisan o danej szerokosci
+// dzieki temu porownania wektorowe dzialaja takze dla -1 (brak przypisania)
+static int raw_part_value(int width, int part)
+{
+    if (part >= 0)
+        return part;
+    if (width == 1)
+        return PART_ID_UNASSIGNED_U8;
+    if (width == 2)
+        return PART_ID_UNASSIGNED_U16;
+    return -1;
+}
+
+// maska wycinajaca element tablicy przypisan z pobranego 32-bitowego slowa
+static int width_mask(int width)
+{
+    if (width == 1)
+        return 0xFF;
+    if (width == 2)
+        return 0xFFFF;
+    return -1;
+}
+
+// skalarna petla po sasiadach
+int gain_kernel_scalar(const Graph *graph, const int *neighbors, int count, int current_part, int target_part)
+{
+    int gain = 0;
+    for (int i = 0; i < count; i++)
+    {
+        int neighbor_part = get_part_id(graph, neighbors[i]);
+
+        // sasiad w partycji docelowej - krawedz przestanie byc przecieta
+        if (neighbor_part == target_part)
+        {
+            gain++;
+        }
+        // sasiad w obecnej partycji - powstanie nowe przeciecie
+        else if (neighbor_part == current_part)
+        {
+            gain--;
+        }
+    }
+    return gain;
+}
+
+#if defined(__AVX512F__)
+// wersja AVX-512, 16 sasiadow na iteracje, koncowka obslugiwana maska
+static int gain_kernel_avx512(const Graph *graph, const int *neighbors, int count, int current_part, int target_part)
+{
+    int width = graph->part_id_width;
+    const void *base = graph->part_ids;
+    const __m512i target = _mm512_set1_epi32(raw_part_value(width, target_part));
+    const __m512i current = _mm512_set1_epi32(raw_part_value(width, current_part));
+    const __m512i mask = _mm512_set1_epi32(width_mask(width));
+    int gain = 0;
+
+    for (int i = 0; i < count; i += 16)
+    {
+        int remaining = count - i;
+        __mmask16 lanes = remaining >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << remaining) - 1);
+        __m512i index = _mm512_maskz_loadu_epi32(lanes, neighbors + i);
+        __m512i parts;
+
+        // skala gather musi byc stala kompilacji, stad osobne wywolania
+        if (width == 1)
+            parts = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), lanes, index, base, 1);
+        else if (width == 2)
+            parts = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), lanes, index, base, 2);
+        else
+            parts = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), lanes, index, base, 4);
+        parts = _mm512_and_si512(parts, mask);
+
+        __mmask16 in_target = _mm512_mask_cmpeq_epi32_mask(lanes, parts, target);
+        __mmask16 in_current = _mm512_mask_cmpeq_epi32_mask(lanes, parts, current);
+        gain += __builtin_popcount(in_target) - __builtin_popcount(in_current & ~in_target);
+    }
+    return gain;
+}
+#elif defined(__AVX2__)
+// wersja AVX2, 8 sasiadow na iteracje, koncowka liczona skalarnie
+static int gain_kernel_avx2(const Graph *graph, const int *neighbors, int count, int current_part, int target_part)
+{
+    int width = graph->part_id_width;
+    const int *base = (const int *)graph->part_ids;
+    const __m256i target = _mm256_set1_epi32(raw_part_value(width, target_part));
+    const __m256i current = _mm256_set1_epi32(raw_part_value(width, current_part));
+    const __m256i mask = _mm256_set1_epi32(width_mask(width));
+    int gain = 0;
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i index = _mm256_loadu_si256((const __m256i *)(neighbors + i));
+        __m256i parts;
+
+        if (width == 1)
+            parts = _mm256_i32gather_epi32(base, index, 1);
+        else if (width == 2)
+            parts = _mm256_i32gather_epi32(base, index, 2);
+        else
+            parts = _mm256_i32gather_epi32(base, index, 4);
+        parts = _mm256_and_si256(parts, mask);
+
+        int in_target = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(parts, target)));
+        int in_current = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(parts, current)));
+        gain += __builtin_popcount(in_target) - __builtin_popcount(in_current & ~in_target);
+    }
+
+    return gain + gain_kernel_scalar(graph, neighbors + i, count - i, current_part, target_part);
+}
+#endif
+
+// wybiera wersje kernela dostepna dla docelowej architektury
+int gain_kernel(const Graph *graph, const int *neighbors, int count, int current_part, int target_part)
+{
+#if defined(__AVX512F__)
+    return gain_kernel_avx512(graph, neighbors, count, current_part, target_part);
+#elif defined(__AVX2__)
+    return gain_kernel_avx2(graph, neighbors, count, current_part, target_part);
+#else
+    return gain_kernel_scalar(graph, neighbors, count, current_part, target_part);
+#endif
+}
@@ -0,0 +1,212 @@
+#include "geometry.h"
+#include "region_growing.h"
+
+// wierzcholek z kluczem sortowania
+typedef struct
+{
+    uint64_t key;
+    int vertex;
+} Curve_point;
+
+// porownanie po kluczu, remis rozstrzyga numer wierzcholka
+static int compare_curve_points(const void *a, const void *b)
+{
+    const Curve_point *pa = a;
+    const Curve_point *pb = b;
+    if (pa->key != pb->key)
+        return pa->key < pb->key ? -1 : 1;
+    return pa->vertex - pb->vertex;
+}
+
+// pozycja punktu na krzywej Hilberta
+uint64_t hilbert_index(int order, uint32_t row, uint32_t col)
+{
+    uint64_t index = 0;
+    uint32_t x = col;
+    uint32_t y = row;
+    for (uint32_t s = (uint32_t)1 << (order - 1); s > 0; s >>= 1)
+    {
+        uint32_t rx = (x & s) ? 1 : 0;
+        uint32_t ry = (y & s) ? 1 : 0;
+        index += (uint64_t)s * s * ((3 * rx) ^ ry);
+
+        // obracamy cwiartke, zeby krzywa w niej zaczynala sie przy poprzedniej
+        // liczy sie tylko dolne bity, wiec przepelnienie przy odejmowaniu nie szkodzi
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = s - 1 - x;
+                y = s - 1 - y;
+            }
+            uint32_t t = x;
+            x = y;
+            y = t;
+        }
+    }
+    return index;
+}
+
+// zwraca wierzcholki w kolejnosci krzywej Hilberta
+int *hilbert_order(const Graph *graph)
+{
+    if (!graph->coord_rows || !graph->coord_cols)
+        return NULL;
+
+    int n = graph->vertices;
+    int *order = malloc((n > 0 ? n : 1) * sizeof(int));
+    Curve_point *points = malloc((n > 0 ? n : 1) * sizeof(Curve_point));
+    if (!order || !points)
+    {
+        perror("Blad alokacji pamieci dla krzywej Hilberta");
+        exit(EXIT_FAILURE);
+    }
+
+    // najmniejszy kwadrat 2^order obejmujacy wszystkie wspolrzedne
+    int extent = 0;
+    for (int v = 0; v < n; v++)
+    {
+        if (graph->coord_rows[v] > extent)
+            extent = graph->coord_rows[v];
+        if (graph->coord_cols[v] > extent)
+            extent = graph->coord_cols[v];
+    }
+    int curve_order = 1;
+    while (curve_order < 31 && ((uint32_t)1 << curve_order) <= (uint32_t)extent)
+        curve_order++;
+
+    for (int v = 0; v < n; v++)
+    {
+        points[v].key = hilbert_index(curve_order, graph->coord_rows[v], graph->coord_cols[v]);
+        points[v].vertex = v;
+    }
+    qsort(points, n, sizeof(Curve_point), compare_curve_points);
+    for (int i = 0; i < n; i++)
+    {
+        order[i] = points[i].vertex;
+    }
+
+    free(points);
+    return order;
+}
+
+// rekurencyjna bisekcja: odcinek vertices[lo, hi) dzielimy wzdluz dluzszego boku jego prostokata
+// na czesci first_part .. first_part + parts - 1, rozmiary polowek sa proporcjonalne do liczby czesci
+static void bisect_coordinates(Graph *graph, int *vertices, Curve_point *points, int lo, int hi, int first_part,
+                               int parts)
+{
+    if (parts == 1)
+    {
+        for (int i = lo; i < hi; i++)
+        {
+            set_part_id(graph, vertices[i], first_part);
+        }
+        return;
+    }
+
+    int min_row = graph->coord_rows[vertices[lo]], max_row = min_row;
+    int min_col = graph->coord_cols[vertices[lo]], max_col = min_col;
+    for (int i = lo + 1; i < hi; i++)
+    {
+        int row = graph->coord_rows[vertices[i]];
+        int col = graph->coord_cols[vertices[i]];
+        if (row < min_row)
+            min_row = row;
+        if (row > max_row)
+            max_row = row;
+        if (col < min_col)
+            min_col = col;
+        if (col > max_col)
+            max_col = col;
+    }
+
+    // klucz to wspolrzedna wzdluz dluzszego boku, druga rozstrzyga remisy
+    int by_rows = max_row - min_row >= max_col - min_col;
+    for (int i = lo; i < hi; i++)
+    {
+        uint32_t row = graph->coord_rows[vertices[i]];
+        uint32_t col = graph->coord_cols[vertices[i]];
+        points[i].key = by_rows ? ((uint64_t)row << 32 | col) : ((uint64_t)col << 32 | row);
+        points[i].vertex = vertices[i];
+    }
+    qsort(points + lo, hi - lo, sizeof(Curve_point), compare_curve_points);
+    for (int i = lo; i < hi; i++)
+    {
+        vertices[i] = points[i].vertex;
+    }
+
+    int left_parts = parts / 2;
+    int split = lo + (int)((long long)(hi - lo) * left_parts / parts);
+    bisect_coordinates(graph, vertices, points, lo, split, first_part, left_parts);
+    bisect_coordinates(graph, vertices, points, split, hi, first_part + left_parts, parts - left_parts);
+}
+
+// podzial wstepny ze wspolrzednych wierzcholkow
+int geometric_partition(Graph *graph, int parts, Partition_data *partition_data, float accuracy,
+                        Geometric_mode mode)
+{
+    if (parts > graph->vertices)
+    {
+        perror("Liczba czesci nie moze byc wieksza od liczby wierzcholkow");
+        exit(EXIT_FAILURE);
+    }
+    if (!graph->coord_rows || !graph->coord_cols)
+    {
+        perror("Graf nie ma wspolrzednych wierzcholkow");
+        exit(EXIT_FAILURE);
+    }
+
+    assing_parts(graph, parts);
+    int n = graph->vertices;
+
+    if (mode == GEOMETRIC_HILBERT)
+    {
+        // czesc p dostaje odcinek krzywej [p * n / parts, (p + 1) * n / parts)
+        int *order = hilbert_order(graph);
+        for (int p = 0; p < parts; p++)
+        {
+            int begin = (int)((long long)n * p / parts);
+            int end = (int)((long long)n * (p + 1) / parts);
+            for (int i = begin; i < end; i++)
+            {
+                set_part_id(graph, order[i], p);
+            }
+        }
+        free(order);
+    }
+    else
+    {
+        int *vertices = malloc((n > 0 ? n : 1) * sizeof(int));
+        Curve_point *points = malloc((n > 0 ? n : 1) * sizeof(Curve_point));
+        if (!vertices || !points)
+        {
+            perror("Blad alokacji pamieci dla bisekcji wspolrzednych");
+            exit(EXIT_FAILURE);
+        }
+        for (int v = 0; v < n; v++)
+        {
+            vertices[v] = v;
+        }
+        bisect_coordinates(graph, vertices, points, 0, n, 0, parts);
+        free(vertices);
+        free(points);
+    }
+
+    // przypiete wierzcholki ida do swoich czesci niezaleznie od polozenia
+    int *part_counts = calloc(parts, sizeof(int));
+    if (!part_counts)
+    {
+        perror("Blad alokacji pamieci dla rozmiarow czesci");
+        exit(EXIT_FAILURE);
+    }
+    for (int v = 0; v < n; v++)
+    {
+        if (is_pinned(graph, v))
+            set_part_id(graph, v, graph->pinned[v]);
+        part_counts[get_part_id(graph, v)]++;
+    }
+
+    int success = complete_partition(graph, parts, partition_data, part_counts, accuracy);
+    free(part_counts);
+    return success;
+}
@@ -1,35 +1,31 @@
 #include "graph.h"
+#include "sell_graph.h"
+#include "quotient_graph.h"
+#include <string.h>
 
-// funkcja wypisuje sasiadow kazdego wierzcholka
-// przyjmuje tablice sasiedztwa i jej rozmiar
-void print_part_neighbors(int **neighbors, int size)
+// funkcja wypisuje sasiadow kazdego wierzcholka czesci
+// przyjmuje sasiedztwo czesci w ukladzie CSR
+void print_part_neighbors(const struct Part_neighbors *part_neighbors)
 {
     // sprawdzam czy dane wejsciowe sa poprawne
-    if (!neighbors || size <= 0)
+    if (!part_neighbors || part_neighbors->size <= 0)
     {
         return;
     }
 
     // iteruje po wszystkich wierzcholkach
-    for (int i = 0; i < size; i++)
+    for (int i = 0; i < part_neighbors->size; i++)
     {
-        // pomijam jesli wierzcholek nie ma przypisanych sasiadow
-        if (!neighbors[i])
+        printf("Wierzchołek %d: ", part_neighbors->vertices[i]);
+        // wypisuje wszystkich sasiadow wierzcholka, dlugosc wynika z przesuniec
+        for (int j = part_neighbors->offsets[i]; j < part_neighbors->offsets[i + 1]; j++)
         {
-            continue;
-        }
-        printf("Wierzchołek %d: ", neighbors[i][0]);
-        int j = 1;
-        // wypisuje wszystkich sasiadow wierzcholka, koncza sie wartoscia -1
-        while (neighbors[i][j] != -1)
-        {
-            printf("%d", neighbors[i][j]);
+            printf("%d", part_neighbors->neighbors[j]);
             // dodaje przecinek jesli to nie ostatni sasiad
-            if (neighbors[i][j + 1] != -1)
+            if (j + 1 < part_neighbors->offsets[i + 1])
             {
                 printf(", ");
             }
-            j++;
         }
         printf("\n");
     }
@@ -45,6 +41,14 @@ void inicialize_graph(Graph *graph, int vertices)
     graph->parts = 0;
     graph->min_count = 0;
     graph->max_count = 0;
+    graph->part_ids = NULL;
+    graph->part_id_width = 0;
+    graph->part_sizes = NULL;
+    graph->sell = NULL;
+    graph->quotient = NULL;
+    graph->pinned = NULL;
+    graph->coord_rows = NULL;
+    graph->coord_cols = NULL;
 
     // alokuje pamiec na wezly grafu
     graph->nodes = malloc(vertices * sizeof(Node));
@@ -59,9 +63,77 @@ void inicialize_graph(Graph *graph, int vertices)
         graph->nodes[i].vertex = i;
         graph->nodes[i].neighbors = NULL;
         graph->nodes[i].neighbor_count = 0;
-        graph->nodes[i].part_id = -1;
         graph->nodes[i].neighbor_capacity = 0;
     }
+
+    // liczba czesci nie jest jeszcze znana, zaczynam od najwezszej tablicy
+    initialize_part_ids(graph, 0);
+}
+
+// dobiera szerokosc elementu tablicy przypisan do liczby czesci
+// jedna wartosc w kazdym typie jest zarezerwowana na brak przypisania
+static int part_id_width_for(int parts)
+{
+    if (parts < PART_ID_UNASSIGNED_U8)
+        return 1;
+    if (parts < PART_ID_UNASSIGNED_U16)
+        return 2;
+    return 4;
+}
+
+// alokuje lub przepakowuje tablice przypisan do szerokosci wystarczajacej dla liczby czesci
+void initialize_part_ids(Graph *graph, int parts)
+{
+    // graf ilorazowy jest zbudowany dla starej liczby czesci
+    free_quotient_graph(graph->quotient);
+    graph->quotient = NULL;
+
+    int width = part_id_width_for(parts);
+    if (!graph->part_ids || graph->part_id_width != width)
+    {
+        // dodatkowe 4 bajty pozwalaja kernelom SIMD czytac 32-bitowe slowa takze przy ostatnim elemencie
+        void *part_ids = malloc((size_t)graph->vertices * width + sizeof(int32_t));
+        if (part_ids == NULL)
+        {
+            perror("Blad alokacji pamieci dla tablicy przypisan");
+            exit(EXIT_FAILURE);
+        }
+        memset((char *)part_ids + (size_t)graph->vertices * width, 0, sizeof(int32_t));
+
+        // przepisuje istniejace przypisania do nowej tablicy
+        Graph packed = *graph;
+        packed.part_ids = part_ids;
+        packed.part_id_width = width;
+        packed.part_sizes = NULL;
+        packed.quotient = NULL;
+        for (int i = 0; i < graph->vertices; i++)
+        {
+            set_part_id(&packed, i, graph->part_ids ? get_part_id(graph, i) : -1);
+        }
+
+        free(graph->part_ids);
+        graph->part_ids = part_ids;
+        graph->part_id_width = width;
+    }
+
+    // przeliczam rozmiary czesci dla nowej liczby czesci
+    free(graph->part_sizes);
+    graph->part_sizes = NULL;
+    if (parts > 0)
+    {
+        graph->part_sizes = calloc(parts, sizeof(int));
+        if (graph->part_sizes == NULL)
+        {
+            perror("Blad alokacji pamieci dla rozmiarow czesci");
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < graph->vertices; i++)
+        {
+            int part = get_part_id(graph, i);
+            if (part >= 0 && part < parts)
+                graph->part_sizes[part]++;
+        }
+    }
 }
 
 // liczy liczbe krawedzi w grafie
@@ -89,7 +161,7 @@ void assign_min_max_count(Graph *graph, int parts, float accuracy)
         return;
     }
 
-    graph->parts = parts;
+    assing_parts(graph, parts);
 
     // licze srednia liczbe wierzcholkow na czesc
     float avg_vertices_per_part = (float)graph->vertices / parts;
@@ -111,16 +183,31 @@ void assign_min_max_count(Graph *graph, int parts, float accuracy)
 void assing_parts(Graph *graph, int parts)
 {
     graph->parts = parts;
+    initialize_part_ids(graph, parts);
 }
 
 // zwalnia pamiec zaalokowana dla grafu
 void free_graph(Graph *graph)
 {
-    // zwalniam pamiec dla kazdego wezla
-    for (int i = 0; i < graph->vertices; i++)
+    // zwalniam pamiec dla kazdego wezla (graf z podzialu strumieniowego nie ma wezlow)
+    for (int i = 0; graph->nodes && i < graph->vertices; i++)
     {
         free(graph->nodes[i].neighbors);
     }
-    // zwalniam pamiec dla tablicy wezlow
+    // zwalniam pamiec dla tablicy wezlow i przypisan
     free(graph->nodes);
+    free(graph->part_ids);
+    free(graph->part_sizes);
+    free_sell_graph(graph->sell);
+    free_quotient_graph(graph->quotient);
+    free(graph->pinned);
+    free(graph->coord_rows);
+    free(graph->coord_cols);
+    graph->part_ids = NULL;
+    graph->part_sizes = NULL;
+    graph->sell = NULL;
+    graph->quotient = NULL;
+    graph->pinned = NULL;
+    graph->coord_rows = NULL;
+    graph->coord_cols = NULL;
 }
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include "halo.h"
+
+// dopisuje liczbe do rosnacej tablicy, pojemnosc podwajamy
+static void append_int(int **items, int *count, int *capacity, int value)
+{
+    if (*count >= *capacity)
+    {
+        int new_capacity = *capacity > 0 ? *capacity * 2 : 16;
+        int *new_items = realloc(*items, new_capacity * sizeof(int));
+        if (!new_items)
+        {
+            perror("Blad alokacji pamieci dla warstwy duchow");
+            exit(EXIT_FAILURE);
+        }
+        *items = new_items;
+        *capacity = new_capacity;
+    }
+    (*items)[(*count)++] = value;
+}
+
+// dane wspolne dla zadan liczenia halo
+typedef struct
+{
+    const Graph *graph;
+    const Part_index *index;
+    Halo_layer *layer;
+} Halo_job;
+
+// zadanie puli - brzeg i halo jednej czesci
+static void build_part_halo_task(void *arg, int part)
+{
+    Halo_job *job = arg;
+    const Graph *graph = job->graph;
+    Part_halo *halo = &job->layer->halos[part];
+    int hops = job->layer->hops;
+    const int *members = job->index->members + job->index->offsets[part];
+    int size = job->index->offsets[part + 1] - job->index->offsets[part];
+
+    memset(halo, 0, sizeof(Part_halo));
+    halo->part = part;
+    int boundary_capacity = 0;
+    int ghost_capacity = 0;
+
+    // bufor watku - oznaczenie to przynaleznosc do halo, etykieta to odleglosc
+    Traversal_workspace *workspace = get_traversal_workspace(graph->vertices);
+    begin_traversal(workspace);
+
+    // pierwszy poziom: sasiedzi zewnetrzni wierzcholkow czesci
+    for (int i = 0; i < size; i++)
+    {
+        int vertex = members[i];
+        int is_boundary = 0;
+        for (int j = 0; j < graph->nodes[vertex].neighbor_count; j++)
+        {
+            int neighbor = graph->nodes[vertex].neighbors[j];
+            int neighbor_part = get_part_id(graph, neighbor);
+            if (neighbor_part < 0 || neighbor_part == part)
+                continue;
+            is_boundary = 1;
+            if (mark_visited(workspace, neighbor))
+            {
+                workspace->labels[neighbor] = 1;
+                append_int(&halo->ghosts, &halo->ghost_count, &ghost_capacity, neighbor);
+            }
+        }
+        if (is_boundary)
+            append_int(&halo->boundary, &halo->boundary_count, &boundary_capacity, vertex);
+    }
+
+    // kolejne poziomy: lista duchow sluzy jako kolejka BFS
+    for (int head = 0; head < halo->ghost_count; head++)
+    {
+        int ghost = halo->ghosts[head];
+        int hop = workspace->labels[ghost];
+        if (hop >= hops)
+            break;
+        for (int j = 0; j < graph->nodes[ghost].neighbor_count; j++)
+        {
+            int neighbor = graph->nodes[ghost].neighbors[j];
+            int neighbor_part = get_part_id(graph, neighbor);
+            if (neighbor_part < 0 || neighbor_part == part)
+                continue;
+            if (mark_visited(workspace, neighbor))
+            {
+                workspace->labels[neighbor] = hop + 1;
+                append_int(&halo->ghosts, &halo->ghost_count, &ghost_capacity, neighbor);
+            }
+        }
+    }
+
+    // wlasciciele i odleglosci duchow
+    int ghosts = halo->ghost_count > 0 ? halo->ghost_count : 1;
+    halo->ghost_owner = malloc(ghosts * sizeof(int));
+    halo->ghost_hop = malloc(ghosts * sizeof(int));
+    if (!halo->ghost_owner || !halo->ghost_hop)
+    {
+        perror("Blad alokacji pamieci dla warstwy duchow");
+        exit(EXIT_FAILURE);
+    }
+
+    // krawedzie halo - kazda ma co najmniej jeden koniec w halo, krawedz miedzy duchami
+    // dodajemy od mniejszego konca
+    int edge_values = 0;
+    int edge_capacity = 0;
+    for (int g = 0; g < halo->ghost_count; g++)
+    {
+        int ghost = halo->ghosts[g];
+        halo->ghost_owner[g] = get_part_id(graph, ghost);
+        halo->ghost_hop[g] = workspace->labels[ghost];
+
+        for (int j = 0; j < graph->nodes[ghost].neighbor_count; j++)
+        {
+            int neighbor = graph->nodes[ghost].neighbors[j];
+            if (get_part_id(graph, neighbor) == part || (is_visited(workspace, neighbor) && neighbor > ghost))
+            {
+                append_int(&halo->edges, &edge_values, &edge_capacity, neighbor);
+                append_int(&halo->edges, &edge_values, &edge_capacity, ghost);
+            }
+        }
+    }
+    halo->edge_count = edge_values / 2;
+}
+
+// liczy brzeg i halo kazdej czesci
+void build_halo_layer(const Graph *graph, int parts, int hops, Halo_layer *layer)
+{
+    layer->parts = parts;
+    layer->hops = hops > 0 ? hops : 1;
+    layer->halos = calloc(parts > 0 ? parts : 1, sizeof(Part_halo));
+    if (!layer->halos)
+    {
+        perror("Blad alokacji pamieci dla warstwy duchow");
+        exit(EXIT_FAILURE);
+    }
+
+    Part_index index;
+    build_part_index(graph, parts, &index);
+
+    // kazda czesc ma wlasne wyniki, a watki wlasne bufory przejsc
+    Halo_job job = {graph, &index, layer};
+    Thread_pool *pool = graph->vertices >= PARALLEL_BFS_MIN_VERTICES ? get_thread_pool() : NULL;
+    parallel_for(pool, parts, build_part_halo_task, &job);
+
+    free_part_index(&index);
+}
+
+// zwalnia warstwy duchow
+void free_halo_layer(Halo_layer *layer)
+{
+    for (int p = 0; p < layer->parts; p++)
+    {
+        Part_halo *halo = &layer->halos[p];
+        free(halo->boundary);
+        free(halo->ghosts);
+        free(halo->ghost_owner);
+        free(halo->ghost_hop);
+        free(halo->edges);
+    }
+    free(layer->halos);
+    layer->halos = NULL;
+    layer->parts = 0;
+}
+
+// zapisuje warstwy duchow
+// HALO czesci glebokosc
+// PART czesc liczba_brzegowych liczba_duchow liczba_krawedzi
+// B wierzcholki brzegowe
+// G duch wlasciciel odleglosc (jeden duch w linii)
+// E u v czesc_u czesc_v (jedna krawedz w linii)
+int write_halo_file(const char *filename, const Graph *graph, const Halo_layer *layer)
+{
+    FILE *file = fopen(filename, "w");
+    if (!file)
+    {
+        perror("nie mozna otworzyc pliku halo do zapisu");
+        return 0;
+    }
+
+    fprintf(file, "HALO %d %d\n", layer->parts, layer->hops);
+    for (int p = 0; p < layer->parts; p++)
+    {
+        const Part_halo *halo = &layer->halos[p];
+        fprintf(file, "PART %d %d %d %d\n", halo->part, halo->boundary_count, halo->ghost_count, halo->edge_count);
+
+        fputc('B', file);
+        for (int i = 0; i < halo->boundary_count; i++)
+        {
+            fprintf(file, " %d", halo->boundary[i]);
+        }
+        fputc('\n', file);
+
+        for (int g = 0; g < halo->ghost_count; g++)
+        {
+            fprintf(file, "G %d %d %d\n", halo->ghosts[g], halo->ghost_owner[g], halo->ghost_hop[g]);
+        }
+
+        for (int e = 0; e < halo->edge_count; e++)
+        {
+            int u = halo->edges[2 * e];
+            int v = halo->edges[2 * e + 1];
+            fprintf(file, "E %d %d %d %d\n", u, v, get_part_id(graph, u), get_part_id(graph, v));
+        }
+    }
+
+    int ok = !ferror(file);
+    if (!ok)
+        perror("blad zapisu pliku halo");
+    fclose(file);
+    return ok;
+}
@@ -11,6 +11,15 @@
 #include <time.h>
 #include "stats.h"
 #include "fm_optimization.h"
+#include "sell_graph.h"
+#include "quotient_graph.h"
+#include "part_file.h"
+#include "halo.h"
+#include "portfolio.h"
+#include "spectral.h"
+#include "exact.h"
+#include "stream_partition.h"
+#include "recursive_bisection.h"
 #include <math.h>
 // wyswietla wszystkie wierzcholki grafu i ich sasiadow
 void print_graph(const Graph *graph)
@@ -49,18 +58,14 @@ void print_data(const Graph *graph, const Partition_data *partition_data, int pa
                 int neighbor = graph->nodes[current_vertex].neighbors[k];
 
                 // sprawdz czy sasiad jest w tej samej czesci
-                for (int l = 0; l < partition_data->parts[i].part_vertex_count; l++)
+                if (is_in_partition(graph, i, neighbor))
                 {
-                    if (partition_data->parts[i].part_vertexes[l] == neighbor)
+                    if (neighbor_count > 0)
                     {
-                        if (neighbor_count > 0)
-                        {
-                            printf(", ");
-                        }
-                        printf("%d", neighbor);
-                        neighbor_count++;
-                        break;
+                        printf(", ");
                     }
+                    printf("%d", neighbor);
+                    neighbor_count++;
                 }
             }
             printf("\n");
@@ -80,7 +85,27 @@ void print_usage(char *program_name)
     printf("  --precompute-metrics -p oblicz metryki przed podzialem\n");
     printf("  --statistics -s       wyswietl szczegolowe statystyki\n");
     printf("  --output -o PLIK      nazwa pliku wyjsciowego (domyslnie: anwser.csrrg)\n");
-    printf("  --out-format text|binary / -k format wyjsciowy (domyslnie: oba)\n");
+    printf("  --out-format text|binary|part|local / -k format wyjsciowy (domyslnie: text i binary)\n");
+    printf("                        part - sam wektor przypisan (plik .part, do odczytu przez mmap)\n");
+    printf("                        local - podgrafy czesci z numeracja lokalna (plik .local)\n");
+    printf("  --pin -P PLIK         plik przypiec: linie 'wierzcholek czesc', przypiete wierzcholki\n");
+    printf("                        sa punktami startowymi swoich czesci i FM ich nie przenosi\n");
+    printf("  --halo -g K           zapisz brzeg i halo o glebokosci K kazdej czesci do pliku .halo\n");
+    printf("  --parallel-growing -r rozrost wszystkich czesci naraz na wielu watkach (duze grafy)\n");
+    printf("  --seeding -S kcenter|d2|sampled|geometric sposob wyboru punktow startowych (domyslnie: kcenter)\n");
+    printf("                        kcenter - zawsze najdalszy od wybranych, d2 - losowanie z waga odleglosc^2\n");
+    printf("                        geometric - rownomiernie po siatce wzdluz krzywej Hilberta\n");
+    printf("  --geometric -G hilbert|rcb podzial wstepny ze wspolrzednych siatki zamiast region growing\n");
+    printf("                        hilbert - odcinki krzywej Hilberta, rcb - rekurencyjna bisekcja wspolrzednych\n");
+    printf("  (male grafy - wierzcholki * (czesci - 1) do %d - najpierw probujemy podzielic dokladnie,\n", EXACT_AUTO_MAX_WORK);
+    printf("   z minimalnym cieciem; gdy przeszukiwanie nie da dowodu, zostaje region growing)\n");
+    printf("  --spectral -e         podzial wstepny przez rekurencyjna bisekcje spektralna (wektor Fiedlera)\n");
+    printf("  --recursive-bisection -b rekurencyjna bisekcja z dwuczesciowym FM na kazdym poziomie,\n");
+    printf("                        bez FM dla wszystkich czesci naraz (duza liczba czesci)\n");
+    printf("  --stream -w ldg|fennel podzial strumieniowy w jednym przejsciu po pliku, bez budowy grafu (tylko .part)\n");
+    printf("  --restarts -n N       N niezaleznych prob (region growing + FM) naraz, zostaje najlepsze ciecie\n");
+    printf("  --threads -t T        liczba watkow puli (domyslnie: liczba rdzeni)\n");
+    printf("  --seed -z S           ziarno generatora liczb losowych (powtarzalne wyniki)\n");
     printf("  --force -f            wymus podzial nawet jesli nie spelnia dokladnosci\n");
     printf("  --iterations -i ilosc iteracji funkcji cut_edges_optimalization\n");
     printf("  -h, --help           pokaz ten komunikat pomocy\n");
@@ -101,6 +126,16 @@ int main(int argc, char *argv[])
     int force = 0;                   // czy wymusic podzial
     int output_format = 3;           // format wyjsciowy (3=oba)
     int show_statistics = 0;         // czy wyswietlic statystyki
+    char *pin_file = NULL;           // plik przypiec wierzcholkow do czesci
+    int halo_hops = 0;               // glebokosc halo (0 = bez pliku .halo)
+    int parallel_growing = 0;        // czy rozrastac czesci rownolegle
+    int geometric = -1;              // podzial geometryczny (-1 = region growing)
+    int spectral = 0;                // czy dzielic bisekcja spektralna
+    int recursive_bisection = 0;     // czy dzielic rekurencyjna bisekcja
+    int streaming = -1;              // ocena podzialu strumieniowego (-1 = wczytanie calego grafu)
+    int restarts = 1;                // liczba niezaleznych prob
+    uint64_t seed = 0;               // ziarno generatora liczb losowych
+    int seed_given = 0;              // czy podano ziarno
 
     // sprawdz czy uzytkownik chce pomocy
     for (int i = 1; i < argc; i++)
@@ -182,6 +217,14 @@ int main(int argc, char *argv[])
             {
                 output_format = 1;
             }
+            else if (strcmp(argv[i + 1], "part") == 0)
+            {
+                output_format = 2;
+            }
+            else if (strcmp(argv[i + 1], "local") == 0)
+            {
+                output_format = 4;
+            }
             else
             {
                 perror("nieznany format wyjsciowy");
@@ -189,6 +232,130 @@ int main(int argc, char *argv[])
             }
             i += 2;
         }
+        else if ((strcmp(argv[i], "--pin") == 0 && i + 1 < argc) ||
+                 (strcmp(argv[i], "-P") == 0 && i + 1 < argc))
+        {
+            pin_file = argv[i + 1];
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "--halo") == 0 && i + 1 < argc) ||
+                 (strcmp(argv[i], "-g") == 0 && i + 1 < argc))
+        {
+            halo_hops = atoi(argv[i + 1]);
+            if (halo_hops <= 0)
+            {
+                perror("glebokosc halo musi byc dodatnia");
+                return 1;
+            }
+            i += 2;
+        }
+        else if (strcmp(argv[i], "--parallel-growing") == 0 || strcmp(argv[i], "-r") == 0)
+        {
+            parallel_growing = 1;
+            i++;
+        }
+        else if ((strcmp(argv[i], "--seeding") == 0 && i + 1 < argc) ||
+                 (strcmp(argv[i], "-S") == 0 && i + 1 < argc))
+        {
+            if (strcmp(argv[i + 1], "kcenter") == 0)
+            {
+                set_seeding_mode(SEEDING_KCENTER);
+            }
+            else if (strcmp(argv[i + 1], "d2") == 0)
+            {
+                set_seeding_mode(SEEDING_D2);
+            }
+            else if (strcmp(argv[i + 1], "sampled") == 0)
+            {
+                set_seeding_mode(SEEDING_SAMPLED);
+            }
+            else if (strcmp(argv[i + 1], "geometric") == 0)
+            {
+                set_seeding_mode(SEEDING_GEOMETRIC);
+            }
+            else
+            {
+                perror("nieznany sposob wyboru punktow startowych");
+                return 1;
+            }
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "--geometric") == 0 && i + 1 < argc) ||
+                 (strcmp(argv[i], "-G") == 0 && i + 1 < argc))
+        {
+            if (strcmp(argv[i + 1], "hilbert") == 0)
+            {
+                geometric = GEOMETRIC_HILBERT;
+            }
+            else if (strcmp(argv[i + 1], "rcb") == 0)
+            {
+                geometric = GEOMETRIC_RCB;
+            }
+            else
+            {
+                perror("nieznany podzial geometryczny");
+                return 1;
+            }
+            i += 2;
+        }
+        else if (strcmp(argv[i], "--spectral") == 0 || strcmp(argv[i], "-e") == 0)
+        {
+            spectral = 1;
+            i++;
+        }
+        else if (strcmp(argv[i], "--recursive-bisection") == 0 || strcmp(argv[i], "-b") == 0)
+        {
+            recursive_bisection = 1;
+            i++;
+        }
+        else if ((strcmp(argv[i], "--stream") == 0 && i + 1 < argc) ||
+                 (strcmp(argv[i], "-w") == 0 && i + 1 < argc))
+        {
+            if (strcmp(argv[i + 1], "ldg") == 0)
+            {
+                streaming = STREAM_LDG;
+            }
+            else if (strcmp(argv[i + 1], "fennel") == 0)
+            {
+                streaming = STREAM_FENNEL;
+            }
+            else
+            {
+                perror("nieznana ocena podzialu strumieniowego");
+                return 1;
+            }
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "--restarts") == 0 && i + 1 < argc) ||
+                 (strcmp(argv[i], "-n") == 0 && i + 1 < argc))
+        {
+            restarts = atoi(argv[i + 1]);
+            if (restarts <= 0)
+            {
+                perror("liczba prob musi byc dodatnia");
+                return 1;
+            }
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "--threads") == 0 && i + 1 < argc) ||
+                 (strcmp(argv[i], "-t") == 0 && i + 1 < argc))
+        {
+            int threads = atoi(argv[i + 1]);
+            if (threads <= 0)
+            {
+                perror("liczba watkow musi byc dodatnia");
+                return 1;
+            }
+            set_thread_count(threads);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "--seed") == 0 && i + 1 < argc) ||
+                 (strcmp(argv[i], "-z") == 0 && i + 1 < argc))
+        {
+            seed = strtoull(argv[i + 1], NULL, 10);
+            seed_given = 1;
+            i += 2;
+        }
         else if (strcmp(argv[i], "--force") == 0 || strcmp(argv[i], "-f") == 0)
         {
             force = 1;
@@ -207,11 +374,37 @@ int main(int argc, char *argv[])
         }
     }
 
+    // bez ziarna kazde uruchomienie jest inne, ziarno wypisujemy zeby dalo sie je powtorzyc
+    if (!seed_given)
+        seed = (uint64_t)time(NULL);
+    seed_random(seed);
+    if (!seed_given)
+        printf("Random seed: %llu (repeat with --seed)\n", (unsigned long long)seed);
+
     // stworz sciezke do pliku wejsciowego
     snprintf(path, sizeof(path), "data/%s", input_file);
 
     // inicjalizacja struktur i pomiar czasu
     clock_t start = clock();
+
+    // podzial strumieniowy nie buduje list sasiadow, wiec zapisujemy tylko wektor przypisan
+    if (streaming >= 0)
+    {
+        Graph streamed;
+        char assignment_path[256];
+        snprintf(assignment_path, sizeof(assignment_path), "data/%s.part", output_file);
+        printf("Input file: %s\n", path);
+        printf("Streaming partition into %d parts (%s)\n", parts, streaming == STREAM_LDG ? "ldg" : "fennel");
+        if (!stream_partition(path, parts, accuracy, streaming, &streamed))
+            return 1;
+        if (output_format != 2)
+            printf("Streaming mode writes only the assignment vector\n");
+        if (write_part_file(assignment_path, &streamed))
+            printf("Assignment written to %s\n", assignment_path);
+        printf("Execution time: %.3f s\n", (double)(clock() - start) / CLOCKS_PER_SEC);
+        free_graph(&streamed);
+        return 0;
+    }
     Graph graph;
     ParsedData data = {0};
     Partition_data partition_data;
@@ -221,14 +414,75 @@ int main(int argc, char *argv[])
     load_graph(path, &graph, &data);
     count_edges(&graph);
     assign_min_max_count(&graph, parts, accuracy);
+
+    // uklad SELL tylko dla grafow o rownym rozkladzie stopni
+    graph.sell = build_sell_graph_if_suitable(&graph);
     printf("Loaded graph with %d vertices and %d edges\n", graph.vertices, graph.edges);
 
+    // przypiecia wczytujemy gdy liczba czesci jest juz znana
+    if (pin_file)
+    {
+        char pin_path[256];
+        snprintf(pin_path, sizeof(pin_path), "data/%s", pin_file);
+        printf("Pinned %d vertices from %s\n", load_pin_file(pin_path, &graph), pin_path);
+    }
+
     // zrob wstepny podzial grafu
     printf("Initializing partition data for %d parts\n", parts);
     initialize_partition_data(&partition_data, parts);
 
     // glowny algorytm podzialu
-    int success = region_growing(&graph, parts, &partition_data, accuracy);
+    int fm_iterations = iteration_limit > 0 ? iteration_limit : 1000;
+    int success;
+
+    // male grafy dzielimy dokladnie, gdy sie nie uda zostaje zwykla sciezka
+    int exact = 0;
+    if (restarts <= 1 && !spectral && geometric < 0 && !recursive_bisection && exact_partition_suitable(&graph, parts))
+    {
+        Exact_result exact_result = exact_partition(&graph, parts, &partition_data, accuracy);
+        exact = exact_result.status;
+        if (exact)
+            printf("Exact partition: minimum cut %d (%ld search nodes)\n", exact_result.cut, exact_result.nodes);
+        else
+            printf("Exact search gave no proven partition, using region growing\n");
+    }
+
+    if (restarts > 1)
+    {
+        // niezalezne proby z FM wewnatrz, zostaje najlepszy zbalansowany podzial
+        printf("Running %d independent trials (seed %llu)...\n", restarts, (unsigned long long)seed);
+        Portfolio_settings settings = {restarts, fm_iterations, parallel_growing, accuracy, seed};
+        Portfolio_result result = run_portfolio(&graph, parts, &partition_data, &settings);
+        printf("Best trial: %d with cut %d (%s)\n", result.best_trial, result.best_cut,
+               result.balanced ? "balanced" : "unbalanced");
+        success = result.balanced;
+    }
+    else if (exact)
+    {
+        success = 1;
+    }
+    else if (recursive_bisection)
+    {
+        printf("Recursive bisection into %d parts\n", parts);
+        success = recursive_bisection_partition(&graph, parts, &partition_data, accuracy);
+    }
+    else if (spectral)
+    {
+        printf("Spectral bisection initial partition\n");
+        success = spectral_partition(&graph, parts, &partition_data, accuracy);
+    }
+    else if (geometric >= 0 && graph.coord_rows)
+    {
+        printf("Geometric initial partition (%s)\n", geometric == GEOMETRIC_HILBERT ? "hilbert" : "rcb");
+        success = geometric_partition(&graph, parts, &partition_data, accuracy, geometric);
+    }
+    else
+    {
+        if (geometric >= 0)
+            printf("Graph has no grid coordinates, using region growing\n");
+        success = parallel_growing ? parallel_region_growing(&graph, parts, &partition_data, accuracy)
+                                   : region_growing(&graph, parts, &partition_data, accuracy);
+    }
     if (!success && !force)
     {
         perror("nie udalo sie osiagnac zadanej dokladnosci, uzyj --force aby wymusic");
@@ -237,18 +491,30 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    // optymalizacja podzialu
-    printf("\nOptimizing with Fiduccia-Mattheyses algorithm...\n");
-    cut_edges_optimization(&graph, &partition_data, iteration_limit > 0 ? iteration_limit : 1000);
+    // graf ilorazowy czesci, dalej aktualizowany przy kazdym ruchu wierzcholka
+    graph.quotient = build_quotient_graph(&graph);
+
+    // optymalizacja podzialu, w trybie wielu prob wykonana juz w kazdej probie, podzialu dokladnego
+    // nie da sie poprawic, a bisekcja rekurencyjna poprawia kazdy poziom dwuczesciowym FM
+    if (restarts <= 1 && !exact && !recursive_bisection)
+    {
+        printf("\nOptimizing with Fiduccia-Mattheyses algorithm...\n");
+        cut_edges_optimization(&graph, &partition_data, fm_iterations);
+    }
 
     // sprawdz spojnosc
     check_partition_connectivity(&graph, parts);
 
+    // FM i naprawa spojnosci zmieniaja tylko tablice przypisan, listy czesci odtwarzamy z niej
+    rebuild_partition_data(&partition_data, &graph);
+
     // przygotuj nazwy plikow wyjsciowych
     char output_path[256];
     char binary_path[256];
+    char assignment_path[256];
     snprintf(output_path, sizeof(output_path), "data/%s.csrrg", output_file);
     snprintf(binary_path, sizeof(binary_path), "data/%s.bin", output_file);
+    snprintf(assignment_path, sizeof(assignment_path), "data/%s.part", output_file);
 
     // zapisz wyniki w odpowiednim formacie
     if (output_format == 3) // zapisz oba
@@ -264,6 +530,31 @@ int main(int argc, char *argv[])
     {
         write_binary(binary_path, &data, &partition_data, &graph, parts);
     }
+    else if (output_format == 2) // tylko wektor przypisan
+    {
+        write_part_file(assignment_path, &graph);
+    }
+    else if (output_format == 4) // podgrafy czesci z numeracja lokalna
+    {
+        char local_path[256];
+        snprintf(local_path, sizeof(local_path), "data/%s.local", output_file);
+        Subgraph_set subgraphs;
+        extract_subgraphs(&graph, parts, &subgraphs);
+        write_local_binary(local_path, &subgraphs);
+        free_subgraphs(&subgraphs);
+    }
+
+    // halo zapisujemy do osobnego pliku, niezaleznie od formatu wyjsciowego
+    if (halo_hops > 0)
+    {
+        char halo_path[256];
+        snprintf(halo_path, sizeof(halo_path), "data/%s.halo", output_file);
+        Halo_layer halo_layer;
+        build_halo_layer(&graph, parts, halo_hops, &halo_layer);
+        if (write_halo_file(halo_path, &graph, &halo_layer))
+            printf("Halo (%d hops) written to %s\n", halo_hops, halo_path);
+        free_halo_layer(&halo_layer);
+    }
 
     // policz czas wykonania
     clock_t end = clock();
@@ -280,12 +571,10 @@ int main(int argc, char *argv[])
         print_precompute_metrics(&graph, &partition_data, parts);
     }
 
-    // pokaz sasiadow pierwszej czesci
-    print_part_neighbors(get_part_neighbors(&graph, &partition_data, 0, NULL), 0);
-
     // posprzataj
     free_graph(&graph);
     free_partition_data(&partition_data, parts);
+    release_traversal_workspace();
 
     return 0;
 }
\ No newline at end of file
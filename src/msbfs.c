@@ -0,0 +1,304 @@
+#include "msbfs.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// alokuje tablice masek wyrownana do rozmiaru maski
+static Msbfs_mask *alloc_masks(int count)
+{
+    size_t bytes = (size_t)(count > 0 ? count : 1) * sizeof(Msbfs_mask);
+    Msbfs_mask *masks = aligned_alloc(sizeof(Msbfs_mask), bytes);
+    if (!masks)
+    {
+        perror("Blad alokacji pamieci dla masek BFS");
+        exit(EXIT_FAILURE);
+    }
+    memset(masks, 0, bytes);
+    return masks;
+}
+
+// tworzy bufory wielozrodlowego BFS
+Msbfs_state *create_msbfs_state(int vertices)
+{
+    Msbfs_state *state = malloc(sizeof(Msbfs_state));
+    if (!state)
+    {
+        perror("Blad alokacji pamieci dla stanu BFS");
+        exit(EXIT_FAILURE);
+    }
+
+    state->vertices = vertices;
+    state->seen = alloc_masks(vertices);
+    state->visit = alloc_masks(vertices);
+    state->next = alloc_masks(vertices);
+    state->frontier = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+    state->next_frontier = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+    state->touched = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+    state->touched_count = 0;
+    if (!state->frontier || !state->next_frontier || !state->touched)
+    {
+        perror("Blad alokacji pamieci dla stanu BFS");
+        exit(EXIT_FAILURE);
+    }
+    return state;
+}
+
+// zwalnia bufory
+void free_msbfs_state(Msbfs_state *state)
+{
+    if (!state)
+        return;
+    free(state->seen);
+    free(state->visit);
+    free(state->next);
+    free(state->frontier);
+    free(state->next_frontier);
+    free(state->touched);
+    free(state);
+}
+
+// sprawdza czy maska jest pusta
+static inline int mask_is_empty(const Msbfs_mask *mask)
+{
+#if defined(__AVX2__)
+    __m256i value = _mm256_load_si256((const __m256i *)mask->words);
+    return _mm256_testz_si256(value, value);
+#else
+    uint64_t any = 0;
+    for (int i = 0; i < MSBFS_WORDS; i++)
+        any |= mask->words[i];
+    return any == 0;
+#endif
+}
+
+// przenosi zrodla z from do sasiada: nowe = from & ~seen, seen |= nowe, next |= nowe
+// zwraca 1 jesli do sasiada dotarlo jakiekolwiek nowe zrodlo
+static inline int propagate_mask(const Msbfs_mask *from, Msbfs_mask *seen, Msbfs_mask *next)
+{
+#if defined(__AVX2__)
+    __m256i source = _mm256_load_si256((const __m256i *)from->words);
+    __m256i seen_value = _mm256_load_si256((const __m256i *)seen->words);
+    __m256i fresh = _mm256_andnot_si256(seen_value, source);
+    if (_mm256_testz_si256(fresh, fresh))
+        return 0;
+    _mm256_store_si256((__m256i *)seen->words, _mm256_or_si256(seen_value, fresh));
+    __m256i next_value = _mm256_load_si256((const __m256i *)next->words);
+    _mm256_store_si256((__m256i *)next->words, _mm256_or_si256(next_value, fresh));
+    return 1;
+#else
+    int any = 0;
+    for (int i = 0; i < MSBFS_WORDS; i++)
+    {
+        uint64_t fresh = from->words[i] & ~seen->words[i];
+        seen->words[i] |= fresh;
+        next->words[i] |= fresh;
+        any |= fresh != 0;
+    }
+    return any;
+#endif
+}
+
+// wielozrodlowy BFS z maskami bitowymi
+int multi_source_bfs(const Graph *graph, Msbfs_state *state, const int *sources, int source_count,
+                     int max_level, Msbfs_visit visit, void *arg)
+{
+    if (source_count > MSBFS_MAX_SOURCES)
+        source_count = MSBFS_MAX_SOURCES;
+
+    int frontier_count = 0;
+    int level = 0;
+    int stop = 0;
+    state->touched_count = 0;
+
+    // poziom 0 - same zrodla, kilka zrodel moze wskazywac ten sam wierzcholek
+    for (int i = 0; i < source_count; i++)
+    {
+        int s = sources[i];
+        if (mask_is_empty(&state->seen[s]))
+        {
+            state->touched[state->touched_count++] = s;
+            state->frontier[frontier_count++] = s;
+        }
+        state->seen[s].words[i >> 6] |= (uint64_t)1 << (i & 63);
+        state->visit[s].words[i >> 6] |= (uint64_t)1 << (i & 63);
+    }
+    for (int i = 0; i < frontier_count && !stop; i++)
+    {
+        int s = state->frontier[i];
+        if (visit && visit(arg, s, 0, &state->visit[s]))
+            stop = 1;
+    }
+
+    while (frontier_count > 0 && !stop && (max_level < 0 || level < max_level))
+    {
+        int next_count = 0;
+
+        // jedno przejscie po sasiedztwie frontu rozwija wszystkie zrodla naraz
+        for (int i = 0; i < frontier_count; i++)
+        {
+            int v = state->frontier[i];
+            const Node *node = &graph->nodes[v];
+            for (int j = 0; j < node->neighbor_count; j++)
+            {
+                int neighbor = node->neighbors[j];
+                int first_touch = mask_is_empty(&state->seen[neighbor]);
+                int was_queued = !mask_is_empty(&state->next[neighbor]);
+                if (propagate_mask(&state->visit[v], &state->seen[neighbor], &state->next[neighbor]))
+                {
+                    if (first_touch)
+                        state->touched[state->touched_count++] = neighbor;
+                    if (!was_queued)
+                        state->next_frontier[next_count++] = neighbor;
+                }
+            }
+        }
+        level++;
+
+        // czyscimy maski biezacego frontu i raportujemy nowy front
+        for (int i = 0; i < frontier_count; i++)
+        {
+            memset(&state->visit[state->frontier[i]], 0, sizeof(Msbfs_mask));
+        }
+        for (int i = 0; i < next_count; i++)
+        {
+            int v = state->next_frontier[i];
+            state->visit[v] = state->next[v];
+            memset(&state->next[v], 0, sizeof(Msbfs_mask));
+            if (!stop && visit && visit(arg, v, level, &state->visit[v]))
+                stop = 1;
+        }
+
+        int *swap = state->frontier;
+        state->frontier = state->next_frontier;
+        state->next_frontier = swap;
+        frontier_count = next_count;
+    }
+
+    // zerujemy tylko to, czego dotknelismy - koszt proporcjonalny do wykonanej pracy
+    for (int i = 0; i < frontier_count; i++)
+    {
+        memset(&state->visit[state->frontier[i]], 0, sizeof(Msbfs_mask));
+    }
+    for (int i = 0; i < state->touched_count; i++)
+    {
+        memset(&state->seen[state->touched[i]], 0, sizeof(Msbfs_mask));
+    }
+    state->touched_count = 0;
+
+    return level;
+}
+
+// dane przebiegu szukajacego najblizszego celu
+typedef struct
+{
+    const unsigned char *is_target;
+    int *distances;   // wyniki dla biezacej paczki kandydatow
+    Msbfs_mask found; // kandydaci ktorzy juz znalezli cel
+    int remaining;    // liczba kandydatow bez wyniku
+} Nearest_target_job;
+
+// zapisuje poziom dla kandydatow, ktorzy pierwszy raz dotarli do celu
+static int nearest_target_visit(void *arg, int vertex, int level, const Msbfs_mask *reached)
+{
+    Nearest_target_job *job = arg;
+    if (!job->is_target[vertex])
+        return 0;
+
+    for (int w = 0; w < MSBFS_WORDS; w++)
+    {
+        uint64_t fresh = reached->words[w] & ~job->found.words[w];
+        job->found.words[w] |= fresh;
+        while (fresh)
+        {
+            int bit = __builtin_ctzll(fresh);
+            fresh &= fresh - 1;
+            job->distances[w * 64 + bit] = level;
+            job->remaining--;
+        }
+    }
+
+    // konczymy gdy wszyscy kandydaci maja wynik
+    return job->remaining == 0;
+}
+
+// odleglosci kandydatow do najblizszego celu
+void nearest_target_distances(const Graph *graph, Msbfs_state *state, const int *candidates, int candidate_count,
+                              const unsigned char *is_target, int *distances)
+{
+    for (int start = 0; start < candidate_count; start += MSBFS_MAX_SOURCES)
+    {
+        int batch = candidate_count - start;
+        if (batch > MSBFS_MAX_SOURCES)
+            batch = MSBFS_MAX_SOURCES;
+
+        Nearest_target_job job;
+        memset(&job, 0, sizeof(job));
+        job.is_target = is_target;
+        job.distances = distances + start;
+        job.remaining = batch;
+        for (int i = 0; i < batch; i++)
+            job.distances[i] = -1;
+
+        multi_source_bfs(graph, state, candidates + start, batch, -1, nearest_target_visit, &job);
+    }
+}
+
+// dane przebiegu liczacego ekscentrycznosci
+typedef struct
+{
+    int *eccentricity;
+} Eccentricity_job;
+
+// ostatni poziom, na ktorym zrodlo cos osiagnelo, to jego ekscentrycznosc
+static int eccentricity_visit(void *arg, int vertex, int level, const Msbfs_mask *reached)
+{
+    (void)vertex;
+    Eccentricity_job *job = arg;
+    for (int w = 0; w < MSBFS_WORDS; w++)
+    {
+        uint64_t bits = reached->words[w];
+        while (bits)
+        {
+            int bit = __builtin_ctzll(bits);
+            bits &= bits - 1;
+            job->eccentricity[w * 64 + bit] = level;
+        }
+    }
+    return 0;
+}
+
+// szacuje srednice grafu
+int estimate_pseudo_diameter(const Graph *graph, Msbfs_state *state, const int *sources, int source_count,
+                             int *eccentricity)
+{
+    int *results = eccentricity ? eccentricity : malloc((source_count > 0 ? source_count : 1) * sizeof(int));
+    if (!results)
+    {
+        perror("Blad alokacji pamieci dla ekscentrycznosci");
+        exit(EXIT_FAILURE);
+    }
+
+    int diameter = 0;
+    for (int start = 0; start < source_count; start += MSBFS_MAX_SOURCES)
+    {
+        int batch = source_count - start;
+        if (batch > MSBFS_MAX_SOURCES)
+            batch = MSBFS_MAX_SOURCES;
+
+        Eccentricity_job job = {results + start};
+        for (int i = 0; i < batch; i++)
+            results[start + i] = 0;
+        multi_source_bfs(graph, state, sources + start, batch, -1, eccentricity_visit, &job);
+
+        for (int i = 0; i < batch; i++)
+        {
+            if (results[start + i] > diameter)
+                diameter = results[start + i];
+        }
+    }
+
+    if (!eccentricity)
+        free(results);
+    return diameter;
+}
@@ -0,0 +1,138 @@
+#include "part_file.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// liczba bitow potrzebna na numer czesci
+uint32_t part_file_bits(uint32_t parts)
+{
+    uint32_t bits = 1;
+    while (bits < 32 && (UINT64_C(1) << bits) < parts)
+    {
+        bits++;
+    }
+    return bits;
+}
+
+// liczba slow 64-bitowych na wpisy wszystkich wierzcholkow
+static size_t part_file_words(uint32_t vertices, uint32_t bits)
+{
+    return (size_t)(((uint64_t)vertices * bits + 63) / 64);
+}
+
+// zapisuje przypisania do pliku .part
+int write_part_file(const char *filename, const Graph *graph)
+{
+    Part_file_header header = {0};
+    memcpy(header.magic, PART_FILE_MAGIC, sizeof(header.magic));
+    header.version = PART_FILE_VERSION;
+    header.vertices = graph->vertices;
+    header.parts = graph->parts;
+    header.bits = part_file_bits(graph->parts);
+
+    // pakujemy wpisy w pamieci, zeby zapisac je jednym wywolaniem
+    size_t word_count = part_file_words(header.vertices, header.bits);
+    uint64_t *words = calloc(word_count > 0 ? word_count : 1, sizeof(uint64_t));
+    if (!words)
+    {
+        perror("blad alokacji pamieci");
+        return 0;
+    }
+
+    for (uint32_t v = 0; v < header.vertices; v++)
+    {
+        int part = get_part_id(graph, v);
+        if (part < 0)
+        {
+            fprintf(stderr, "wierzcholek %u nie ma przypisanej czesci\n", v);
+            free(words);
+            return 0;
+        }
+
+        uint64_t bit = (uint64_t)v * header.bits;
+        uint32_t shift = bit & 63;
+        words[bit >> 6] |= (uint64_t)part << shift;
+        if (shift + header.bits > 64)
+            words[(bit >> 6) + 1] |= (uint64_t)part >> (64 - shift);
+    }
+
+    FILE *file = fopen(filename, "wb");
+    if (!file)
+    {
+        perror("nie mozna otworzyc pliku .part do zapisu");
+        free(words);
+        return 0;
+    }
+
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(words, sizeof(uint64_t), word_count, file) == word_count;
+    if (!ok)
+        perror("blad zapisu pliku .part");
+
+    free(words);
+    fclose(file);
+    return ok;
+}
+
+// otwiera plik .part przez mmap
+int open_part_file(const char *filename, Part_file *file)
+{
+    memset(file, 0, sizeof(*file));
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        perror("nie mozna otworzyc pliku .part");
+        return 0;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(Part_file_header))
+    {
+        fprintf(stderr, "plik .part jest za krotki\n");
+        close(fd);
+        return 0;
+    }
+
+    void *map = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        perror("blad mmap pliku .part");
+        return 0;
+    }
+
+    // sprawdzamy naglowek i czy dane miesci sie w pliku
+    const Part_file_header *header = map;
+    size_t expected = sizeof(Part_file_header) + part_file_words(header->vertices, header->bits) * sizeof(uint64_t);
+    if (memcmp(header->magic, PART_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != PART_FILE_VERSION || header->bits == 0 || header->bits > 32 ||
+        (size_t)info.st_size < expected)
+    {
+        fprintf(stderr, "nieprawidlowy naglowek pliku .part\n");
+        munmap(map, info.st_size);
+        return 0;
+    }
+
+    file->map = map;
+    file->length = info.st_size;
+    file->vertices = header->vertices;
+    file->parts = header->parts;
+    file->bits = header->bits;
+    file->words = (const uint64_t *)((const char *)map + sizeof(Part_file_header));
+    return 1;
+}
+
+// zamyka plik .part
+void close_part_file(Part_file *file)
+{
+    if (file && file->map)
+    {
+        munmap(file->map, file->length);
+    }
+    if (file)
+    {
+        memset(file, 0, sizeof(*file));
+    }
+}
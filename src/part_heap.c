@@ -0,0 +1,122 @@
+#include "part_heap.h"
+
+// tworzy pusty kopiec
+Part_heap *create_part_heap(int parts, const int *keys)
+{
+    Part_heap *heap = malloc(sizeof(Part_heap));
+    if (!heap)
+    {
+        perror("Blad alokacji pamieci dla kopca czesci");
+        exit(EXIT_FAILURE);
+    }
+
+    heap->size = 0;
+    heap->keys = keys;
+    heap->heap = malloc((parts > 0 ? parts : 1) * sizeof(int));
+    heap->position = malloc((parts > 0 ? parts : 1) * sizeof(int));
+    if (!heap->heap || !heap->position)
+    {
+        perror("Blad alokacji pamieci dla kopca czesci");
+        exit(EXIT_FAILURE);
+    }
+    for (int p = 0; p < parts; p++)
+    {
+        heap->position[p] = -1;
+    }
+    return heap;
+}
+
+// zwalnia kopiec
+void free_part_heap(Part_heap *heap)
+{
+    if (!heap)
+        return;
+    free(heap->heap);
+    free(heap->position);
+    free(heap);
+}
+
+// porownanie czesci - mniejszy klucz, przy remisie mniejszy numer
+static inline int heap_less(const Part_heap *heap, int a, int b)
+{
+    return heap->keys[a] < heap->keys[b] || (heap->keys[a] == heap->keys[b] && a < b);
+}
+
+// ustawia czesc na pozycji kopca
+static inline void heap_place(Part_heap *heap, int index, int part)
+{
+    heap->heap[index] = part;
+    heap->position[part] = index;
+}
+
+// przesuwa czesc w gore kopca
+static void sift_up(Part_heap *heap, int index)
+{
+    int part = heap->heap[index];
+    while (index > 0)
+    {
+        int parent = (index - 1) / 2;
+        if (!heap_less(heap, part, heap->heap[parent]))
+            break;
+        heap_place(heap, index, heap->heap[parent]);
+        index = parent;
+    }
+    heap_place(heap, index, part);
+}
+
+// przesuwa czesc w dol kopca
+static void sift_down(Part_heap *heap, int index)
+{
+    int part = heap->heap[index];
+    while (1)
+    {
+        int child = 2 * index + 1;
+        if (child >= heap->size)
+            break;
+        if (child + 1 < heap->size && heap_less(heap, heap->heap[child + 1], heap->heap[child]))
+            child++;
+        if (!heap_less(heap, heap->heap[child], part))
+            break;
+        heap_place(heap, index, heap->heap[child]);
+        index = child;
+    }
+    heap_place(heap, index, part);
+}
+
+// dodaje czesc do kopca
+void part_heap_push(Part_heap *heap, int part)
+{
+    if (heap->position[part] >= 0)
+        return;
+    heap_place(heap, heap->size++, part);
+    sift_up(heap, heap->size - 1);
+}
+
+// usuwa czesc z kopca
+void part_heap_remove(Part_heap *heap, int part)
+{
+    int index = heap->position[part];
+    if (index < 0)
+        return;
+
+    heap->position[part] = -1;
+    heap->size--;
+    if (index == heap->size)
+        return;
+
+    // ostatnia czesc zajmuje zwolnione miejsce i idzie w gore albo w dol
+    int moved = heap->heap[heap->size];
+    heap_place(heap, index, moved);
+    sift_up(heap, index);
+    sift_down(heap, heap->position[moved]);
+}
+
+// przywraca porzadek po zmianie klucza
+void part_heap_update(Part_heap *heap, int part)
+{
+    int index = heap->position[part];
+    if (index < 0)
+        return;
+    sift_up(heap, index);
+    sift_down(heap, heap->position[part]);
+}
@@ -1,134 +1,166 @@
 #include "partition.h"
 
 // funkcja pomocnicza do porownywania liczb calkowitych, uzywana przez qsort
+// porownanie bez odejmowania, zeby nie bylo przepelnienia
 static int compare_ints(const void *a, const void *b)
 {
-    return (*(int *)a - *(int *)b);
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
 }
 
 // sprawdza czy wierzcholek nalezy do danej partycji
-static int is_in_partition(const Partition_data *partition_data, int part_id, int vertex)
+// przynaleznosc czytamy z tablicy przypisan grafu, wiec to jedno odwolanie do pamieci
+int is_in_partition(const Graph *graph, int part_id, int vertex)
 {
-    if (!partition_data || part_id < 0 || part_id >= partition_data->parts_count)
+    if (!graph || part_id < 0 || part_id >= graph->parts || vertex < 0 || vertex >= graph->vertices)
     {
         return 0;
     }
-
-    // przegladam wszystkie wierzcholki w partycji
-    for (int i = 0; i < partition_data->parts[part_id].part_vertex_count; i++)
-    {
-        if (partition_data->parts[part_id].part_vertexes[i] == vertex)
-        {
-            return 1;
-        }
-    }
-    return 0;
+    return get_part_id(graph, vertex) == part_id;
 }
 
-// tworzy liste sasiadow dla kazdego wierzcholka w danej partycji
-int **get_part_neighbors(const Graph *graph, const Partition_data *partition_data, int part_id, int *size)
+// odbudowuje listy wierzcholkow czesci z tablicy przypisan grafu
+// partition_data jest tylko widokiem, zrodlem prawdy jest graf
+void rebuild_partition_data(Partition_data *partition_data, const Graph *graph)
 {
-    if (!graph || !partition_data || !size || part_id < 0)
+    if (!partition_data || !graph)
     {
-        return NULL;
+        return;
     }
 
-    // pobieram liczbe wierzcholkow w partycji
-    *size = partition_data->parts[part_id].part_vertex_count;
-    if (*size <= 0)
-    {
-        return NULL;
-    }
+    int parts = partition_data->parts_count;
 
-    // tworze tablice na posortowane wierzcholki
-    int *vertices = malloc(*size * sizeof(int));
-    if (!vertices)
+    // bufor ma miejsce na wszystkie wierzcholki grafu
+    if (partition_data->vertex_capacity < graph->vertices)
     {
-        return NULL;
+        int *new_vertices = realloc(partition_data->vertices, graph->vertices * sizeof(int));
+        if (!new_vertices)
+        {
+            perror("Memory allocation error for part vertices");
+            exit(EXIT_FAILURE);
+        }
+        partition_data->vertices = new_vertices;
+        partition_data->vertex_capacity = graph->vertices;
     }
 
-    // kopiuje i sortuje wierzcholki
-    memcpy(vertices, partition_data->parts[part_id].part_vertexes, *size * sizeof(int));
-    qsort(vertices, *size, sizeof(int), compare_ints);
-
-    // alokuje tablice tablic sasiadow
-    int **neighbors = malloc(*size * sizeof(int *));
-    if (!neighbors)
+    // rozmiary czesci sa utrzymywane w grafie, bez nich liczymy je sami
+    int *offsets = partition_data->offsets;
+    memset(offsets, 0, (parts + 1) * sizeof(int));
+    if (graph->part_sizes && graph->parts == parts)
     {
-        free(vertices);
-        return NULL;
+        for (int i = 0; i < parts; i++)
+        {
+            offsets[i + 1] = graph->part_sizes[i];
+        }
     }
-
-    // dla kazdego wierzcholka w kolejnosci posortowanej
-    for (int i = 0; i < *size; i++)
+    else
     {
-        int vertex = vertices[i];
-        int max_neighbors = graph->nodes[vertex].neighbor_count;
-
-        // tworze tymczasowa tablice na sasiadow
-        int *temp_neighbors = malloc(max_neighbors * sizeof(int));
-        int neighbor_count = 0;
-
-        if (!temp_neighbors)
+        for (int v = 0; v < graph->vertices; v++)
         {
-            // sprzatam w przypadku bledu
-            for (int j = 0; j < i; j++)
+            int part = get_part_id(graph, v);
+            if (part >= 0 && part < parts)
             {
-                free(neighbors[j]);
+                offsets[part + 1]++;
             }
-            free(neighbors);
-            free(vertices);
-            return NULL;
         }
+    }
+    for (int i = 0; i < parts; i++)
+    {
+        offsets[i + 1] += offsets[i];
+    }
 
-        // szukam rzeczywistych sasiadow w tej samej partycji
-        for (int j = 0; j < max_neighbors; j++)
+    // rozkladamy wierzcholki, kazda czesc dostaje je w rosnacej kolejnosci numerow
+    for (int i = 0; i < parts; i++)
+    {
+        partition_data->parts[i].part_vertexes = partition_data->vertices + offsets[i];
+        partition_data->parts[i].part_vertex_count = 0;
+    }
+    for (int v = 0; v < graph->vertices; v++)
+    {
+        int part = get_part_id(graph, v);
+        if (part >= 0 && part < parts)
         {
-            int neighbor = graph->nodes[vertex].neighbors[j];
-            if (is_in_partition(partition_data, part_id, neighbor))
-            {
-                temp_neighbors[neighbor_count++] = neighbor;
-            }
+            Part *target = &partition_data->parts[part];
+            target->part_vertexes[target->part_vertex_count++] = v;
         }
+    }
+}
 
-        // sortuje sasiadow jesli jakichs znalazlem
-        if (neighbor_count > 0)
-        {
-            qsort(temp_neighbors, neighbor_count, sizeof(int), compare_ints);
-        }
+// tworzy sasiedztwo wewnatrz partycji w ukladzie CSR
+int get_part_neighbors(const Graph *graph, const Partition_data *partition_data, int part_id, Part_neighbors *result)
+{
+    if (!graph || !partition_data || !result || part_id < 0 || part_id >= partition_data->parts_count)
+    {
+        return 0;
+    }
+
+    const Part *part = &partition_data->parts[part_id];
+    result->size = part->part_vertex_count;
+
+    // liste sasiadow ograniczamy z gory suma stopni, wiec wszystko alokujemy od razu
+    long capacity = 0;
+    for (int i = 0; i < part->part_vertex_count; i++)
+    {
+        capacity += graph->nodes[part->part_vertexes[i]].neighbor_count;
+    }
 
-        // alokuje koncowa tablice dla wierzcholka i jego sasiadow (+ miejsce na sam wierzcholek i terminator)
-        neighbors[i] = malloc((neighbor_count + 2) * sizeof(int));
-        if (!neighbors[i])
+    result->vertices = malloc((result->size > 0 ? result->size : 1) * sizeof(int));
+    result->offsets = malloc((result->size + 1) * sizeof(int));
+    result->neighbors = malloc((capacity > 0 ? capacity : 1) * sizeof(int));
+    if (!result->vertices || !result->offsets || !result->neighbors)
+    {
+        free_part_neighbors(result);
+        return 0;
+    }
+
+    // wierzcholki czesci sa juz posortowane przez odtworzenie z tablicy przypisan
+    memcpy(result->vertices, part->part_vertexes, result->size * sizeof(int));
+
+    // jedno przejscie: kopiujemy sasiadow z tej samej czesci
+    int count = 0;
+    result->offsets[0] = 0;
+    for (int i = 0; i < result->size; i++)
+    {
+        const Node *node = &graph->nodes[result->vertices[i]];
+        int start = count;
+        int sorted = 1;
+        for (int j = 0; j < node->neighbor_count; j++)
         {
-            // sprzatam w przypadku bledu
-            for (int j = 0; j < i; j++)
+            int neighbor = node->neighbors[j];
+            if (is_in_partition(graph, part_id, neighbor))
             {
-                free(neighbors[j]);
+                if (count > start && result->neighbors[count - 1] > neighbor)
+                    sorted = 0;
+                result->neighbors[count++] = neighbor;
             }
-            free(neighbors);
-            free(vertices);
-            free(temp_neighbors);
-            return NULL;
         }
 
-        // zapisuje sam wierzcholek jako pierwszy element
-        neighbors[i][0] = vertex;
-
-        // kopiuje posortowanych sasiadow
-        for (int j = 0; j < neighbor_count; j++)
+        // listy wczytane z pliku sa posortowane, sortujemy tylko gdy trzeba
+        if (!sorted)
         {
-            neighbors[i][j + 1] = temp_neighbors[j];
+            qsort(result->neighbors + start, count - start, sizeof(int), compare_ints);
         }
+        result->offsets[i + 1] = count;
+    }
 
-        // dodaje terminator (-1) na koniec listy sasiadow
-        neighbors[i][neighbor_count + 1] = -1;
+    return 1;
+}
 
-        free(temp_neighbors);
+// zwalnia tablice sasiedztwa czesci
+void free_part_neighbors(Part_neighbors *part_neighbors)
+{
+    if (!part_neighbors)
+    {
+        return;
     }
-
-    free(vertices);
-    return neighbors;
+    free(part_neighbors->vertices);
+    free(part_neighbors->offsets);
+    free(part_neighbors->neighbors);
+    part_neighbors->vertices = NULL;
+    part_neighbors->offsets = NULL;
+    part_neighbors->neighbors = NULL;
+    part_neighbors->size = 0;
 }
 
 // inicjalizuje strukture danych partycji
@@ -151,13 +183,22 @@ void initialize_partition_data(Partition_data *partition_data, int parts)
         exit(EXIT_FAILURE);
     }
 
+    // bufor wierzcholkow powstaje dopiero przy pierwszym odtworzeniu z grafu
+    partition_data->offsets = calloc(parts + 1, sizeof(int));
+    if (!partition_data->offsets)
+    {
+        perror("Memory allocation error for part offsets");
+        exit(EXIT_FAILURE);
+    }
+    partition_data->vertices = NULL;
+    partition_data->vertex_capacity = 0;
+
     // inicjalizuje kazda partycje
     for (int i = 0; i < parts; i++)
     {
         partition_data->parts[i].part_id = i;
         partition_data->parts[i].part_vertexes = NULL;
         partition_data->parts[i].part_vertex_count = 0;
-        partition_data->parts[i].capacity = 0;
     }
 }
 
@@ -169,15 +210,15 @@ void free_partition_data(Partition_data *partition_data, int parts)
         return;
     }
 
-    // zwalniam pamiec dla kazdej partycji
-    if (partition_data->parts)
-    {
-        for (int i = 0; i < parts; i++)
-        {
-            free(partition_data->parts[i].part_vertexes);
-        }
-        free(partition_data->parts);
-    }
+    // listy czesci wskazuja na wspolny bufor, wiec zwalniam go raz
+    (void)parts;
+    free(partition_data->parts);
+    free(partition_data->offsets);
+    free(partition_data->vertices);
+    partition_data->parts = NULL;
+    partition_data->offsets = NULL;
+    partition_data->vertices = NULL;
+    partition_data->vertex_capacity = 0;
 }
 
 // wypisuje informacje o partycjach
@@ -207,45 +248,3 @@ void print_partition_data(const Partition_data *partition_data)
         printf("Part %d: %d\n", i, partition_data->parts[i].part_vertex_count);
     }
 }
-
-// dodaje wierzcholek do partycji z automatycznym zwiekszaniem tablicy jesli potrzeba
-void add_partition_data(Partition_data *partition_data, int part_id, int vertex)
-{
-    if (!partition_data || part_id < 0 || part_id >= partition_data->parts_count)
-    {
-        fprintf(stderr, "Invalid partition data or part_id\n");
-        return;
-    }
-
-    // sprawdzam czy trzeba zainicjalizowac tablice wierzcholkow
-    if (partition_data->parts[part_id].part_vertexes == NULL)
-    {
-        // inicjalna alokacja z pojemnoscia 128 elementow
-        partition_data->parts[part_id].capacity = 128;
-        partition_data->parts[part_id].part_vertexes = malloc(partition_data->parts[part_id].capacity * sizeof(int));
-        if (!partition_data->parts[part_id].part_vertexes)
-        {
-            perror("Memory allocation error for part vertices");
-            exit(EXIT_FAILURE);
-        }
-        partition_data->parts[part_id].part_vertex_count = 0;
-    }
-    // sprawdzam czy trzeba powiekszyc tablice
-    else if (partition_data->parts[part_id].part_vertex_count >= partition_data->parts[part_id].capacity)
-    {
-        // podwajam pojemnosc
-        partition_data->parts[part_id].capacity *= 2;
-        int *new_vertexes = realloc(partition_data->parts[part_id].part_vertexes,
-                                    partition_data->parts[part_id].capacity * sizeof(int));
-        if (!new_vertexes)
-        {
-            perror("Memory reallocation error for part vertices");
-            exit(EXIT_FAILURE);
-        }
-        partition_data->parts[part_id].part_vertexes = new_vertexes;
-    }
-
-    // dodaje nowy wierzcholek
-    partition_data->parts[part_id].part_vertexes[partition_data->parts[part_id].part_vertex_count++] = vertex;
-}
-
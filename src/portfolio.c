@@ -0,0 +1,108 @@
+#include "portfolio.h"
+
+// dane wspolne dla prob
+typedef struct
+{
+    const Graph *graph;
+    int parts;
+    const Portfolio_settings *settings;
+    pthread_mutex_t lock;  // chroni najlepszy wynik
+    int *best_assignment;  // przypisania najlepszej proby
+    Portfolio_result best; // najlepsza dotad proba
+} Portfolio_job;
+
+// sprawdza czy wszystkie czesci mieszcza sie w dozwolonych rozmiarach
+static int is_balanced(const Graph *graph, int parts)
+{
+    for (int p = 0; p < parts; p++)
+    {
+        if (graph->part_sizes[p] < graph->min_count || graph->part_sizes[p] > graph->max_count)
+            return 0;
+    }
+    return 1;
+}
+
+// zadanie puli - jedna proba na prywatnej kopii stanu podzialu
+static void run_trial_task(void *arg, int trial)
+{
+    Portfolio_job *job = arg;
+    const Portfolio_settings *settings = job->settings;
+
+    // sasiedztwo, uklad SELL i przypiecia sa tylko czytane, wlasne sa tablice przypisan i rozmiarow
+    Graph graph = *job->graph;
+    graph.part_ids = NULL;
+    graph.part_sizes = NULL;
+    graph.quotient = NULL;
+
+    seed_random(settings->seed + (uint64_t)trial);
+    set_fm_quiet(1);
+
+    Partition_data partition_data;
+    initialize_partition_data(&partition_data, job->parts);
+    if (settings->parallel_growing)
+        parallel_region_growing(&graph, job->parts, &partition_data, settings->accuracy);
+    else
+        region_growing(&graph, job->parts, &partition_data, settings->accuracy);
+    cut_edges_optimization(&graph, &partition_data, settings->fm_iterations);
+
+    int cut = count_cut_edges(&graph);
+    int balanced = is_balanced(&graph, job->parts);
+
+    // porzadek nie zalezy od kolejnosci konczenia prob
+    pthread_mutex_lock(&job->lock);
+    Portfolio_result *best = &job->best;
+    if (best->best_trial < 0 || balanced > best->balanced ||
+        (balanced == best->balanced && (cut < best->best_cut || (cut == best->best_cut && trial < best->best_trial))))
+    {
+        best->best_trial = trial;
+        best->best_cut = cut;
+        best->balanced = balanced;
+        for (int v = 0; v < graph.vertices; v++)
+        {
+            job->best_assignment[v] = get_part_id(&graph, v);
+        }
+    }
+    pthread_mutex_unlock(&job->lock);
+
+    set_fm_quiet(0);
+    free_partition_data(&partition_data, job->parts);
+    free_quotient_graph(graph.quotient);
+    free(graph.part_ids);
+    free(graph.part_sizes);
+}
+
+// uruchamia proby i zostawia najlepszy podzial
+Portfolio_result run_portfolio(Graph *graph, int parts, Partition_data *partition_data,
+                               const Portfolio_settings *settings)
+{
+    Portfolio_job job;
+    job.graph = graph;
+    job.parts = parts;
+    job.settings = settings;
+    job.best.best_trial = -1;
+    job.best.best_cut = 0;
+    job.best.balanced = 0;
+    job.best_assignment = malloc((graph->vertices > 0 ? graph->vertices : 1) * sizeof(int));
+    if (!job.best_assignment)
+    {
+        perror("Blad alokacji pamieci dla najlepszego podzialu");
+        exit(EXIT_FAILURE);
+    }
+    pthread_mutex_init(&job.lock, NULL);
+
+    // proby wewnatrz zadania uzywaja puli szeregowo, wiec rownoleglosc jest na poziomie prob
+    Thread_pool *pool = settings->restarts > 1 ? get_thread_pool() : NULL;
+    parallel_for(pool, settings->restarts, run_trial_task, &job);
+
+    // najlepsze przypisania przenosimy do grafu wywolujacego
+    assing_parts(graph, parts);
+    for (int v = 0; v < graph->vertices; v++)
+    {
+        set_part_id(graph, v, job.best_assignment[v]);
+    }
+    rebuild_partition_data(partition_data, graph);
+
+    pthread_mutex_destroy(&job.lock);
+    free(job.best_assignment);
+    return job.best;
+}
@@ -0,0 +1,225 @@
+#include "quotient_graph.h"
+
+// krawedz jest przecieta gdy oba konce sa przypisane do roznych czesci
+static inline int is_external(int part_a, int part_b)
+{
+    return part_a >= 0 && part_b >= 0 && part_a != part_b;
+}
+
+// zmienia wage krawedzi a-b w wierszu czesci a, usuwa krawedz gdy waga spadnie do zera
+static void add_row_weight(Quotient_graph *quotient, int a, int b, int delta)
+{
+    int *adjacent = quotient->adjacent[a];
+    for (int i = 0; i < quotient->degree[a]; i++)
+    {
+        if (adjacent[i] == b)
+        {
+            quotient->weights[a][i] += delta;
+            if (quotient->weights[a][i] == 0)
+            {
+                // przenosimy ostatnia pozycje na miejsce usunietej
+                int last = --quotient->degree[a];
+                adjacent[i] = adjacent[last];
+                quotient->weights[a][i] = quotient->weights[a][last];
+            }
+            return;
+        }
+    }
+
+    // nowa sasiednia czesc, listy sa krotkie wiec powiekszamy je o dwa razy
+    if (quotient->degree[a] >= quotient->capacity[a])
+    {
+        int capacity = quotient->capacity[a] > 0 ? quotient->capacity[a] * 2 : 4;
+        int *new_adjacent = realloc(quotient->adjacent[a], capacity * sizeof(int));
+        int *new_weights = realloc(quotient->weights[a], capacity * sizeof(int));
+        if (!new_adjacent || !new_weights)
+        {
+            perror("Blad alokacji pamieci dla grafu ilorazowego");
+            exit(EXIT_FAILURE);
+        }
+        quotient->adjacent[a] = new_adjacent;
+        quotient->weights[a] = new_weights;
+        quotient->capacity[a] = capacity;
+    }
+    quotient->adjacent[a][quotient->degree[a]] = b;
+    quotient->weights[a][quotient->degree[a]] = delta;
+    quotient->degree[a]++;
+}
+
+// zmienia wage krawedzi a-b w obu wierszach
+static void add_weight(Quotient_graph *quotient, int a, int b, int delta)
+{
+    add_row_weight(quotient, a, b, delta);
+    add_row_weight(quotient, b, a, delta);
+    quotient->total_cut += delta;
+}
+
+// buduje graf ilorazowy z biezacego podzialu
+Quotient_graph *build_quotient_graph(const Graph *graph)
+{
+    Quotient_graph *quotient = malloc(sizeof(Quotient_graph));
+    if (!quotient)
+    {
+        perror("Blad alokacji pamieci dla grafu ilorazowego");
+        exit(EXIT_FAILURE);
+    }
+
+    int parts = graph->parts > 0 ? graph->parts : 1;
+    quotient->parts = graph->parts;
+    quotient->vertices = graph->vertices;
+    quotient->total_cut = 0;
+    quotient->degree = calloc(parts, sizeof(int));
+    quotient->capacity = calloc(parts, sizeof(int));
+    quotient->adjacent = calloc(parts, sizeof(int *));
+    quotient->weights = calloc(parts, sizeof(int *));
+    quotient->boundary_count = calloc(parts, sizeof(int));
+    quotient->external_degree = calloc(graph->vertices > 0 ? graph->vertices : 1, sizeof(int));
+    if (!quotient->degree || !quotient->capacity || !quotient->adjacent || !quotient->weights ||
+        !quotient->boundary_count || !quotient->external_degree)
+    {
+        perror("Blad alokacji pamieci dla grafu ilorazowego");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int v = 0; v < graph->vertices; v++)
+    {
+        int part = get_part_id(graph, v);
+        if (part < 0 || part >= quotient->parts)
+            continue;
+
+        for (int j = 0; j < graph->nodes[v].neighbor_count; j++)
+        {
+            int neighbor = graph->nodes[v].neighbors[j];
+            int neighbor_part = get_part_id(graph, neighbor);
+            if (!is_external(part, neighbor_part) || neighbor_part >= quotient->parts)
+                continue;
+
+            quotient->external_degree[v]++;
+            // kazda krawedz dodajemy raz, od mniejszego konca
+            if (v < neighbor)
+                add_weight(quotient, part, neighbor_part, 1);
+        }
+
+        if (quotient->external_degree[v] > 0)
+            quotient->boundary_count[part]++;
+    }
+
+    return quotient;
+}
+
+// zwalnia graf ilorazowy
+void free_quotient_graph(Quotient_graph *quotient)
+{
+    if (!quotient)
+        return;
+
+    for (int i = 0; i < quotient->parts; i++)
+    {
+        free(quotient->adjacent[i]);
+        free(quotient->weights[i]);
+    }
+    free(quotient->degree);
+    free(quotient->capacity);
+    free(quotient->adjacent);
+    free(quotient->weights);
+    free(quotient->boundary_count);
+    free(quotient->external_degree);
+    free(quotient);
+}
+
+// zmienia liczbe sasiadow zewnetrznych wierzcholka i licznik wierzcholkow granicznych jego czesci
+static inline void update_external(Quotient_graph *quotient, int vertex, int part, int delta)
+{
+    int before = quotient->external_degree[vertex];
+    quotient->external_degree[vertex] = before + delta;
+    if (part < 0)
+        return;
+    if (before == 0 && before + delta > 0)
+        quotient->boundary_count[part]++;
+    else if (before > 0 && before + delta == 0)
+        quotient->boundary_count[part]--;
+}
+
+// uwzglednia przeniesienie wierzcholka, przeglada tylko jego sasiadow
+void quotient_move_vertex(Quotient_graph *quotient, const Graph *graph, int vertex, int from, int to)
+{
+    if (from == to)
+        return;
+    if (from >= quotient->parts || to >= quotient->parts)
+        return;
+
+    // wierzcholek opuszcza stara czesc razem ze swoimi sasiadami zewnetrznymi
+    if (from >= 0 && quotient->external_degree[vertex] > 0)
+        quotient->boundary_count[from]--;
+    int external = 0;
+
+    for (int j = 0; j < graph->nodes[vertex].neighbor_count; j++)
+    {
+        int neighbor = graph->nodes[vertex].neighbors[j];
+        if (neighbor == vertex)
+            continue;
+        int neighbor_part = get_part_id(graph, neighbor);
+        if (neighbor_part < 0 || neighbor_part >= quotient->parts)
+            continue;
+
+        int was_cut = is_external(from, neighbor_part);
+        int is_cut = is_external(to, neighbor_part);
+        if (was_cut)
+            add_weight(quotient, from, neighbor_part, -1);
+        if (is_cut)
+        {
+            add_weight(quotient, to, neighbor_part, 1);
+            external++;
+        }
+        if (was_cut != is_cut)
+            update_external(quotient, neighbor, neighbor_part, is_cut - was_cut);
+    }
+
+    quotient->external_degree[vertex] = external;
+    if (to >= 0 && external > 0)
+        quotient->boundary_count[to]++;
+}
+
+// zwraca liczbe przecietych krawedzi miedzy czesciami a i b
+int quotient_cut_weight(const Quotient_graph *quotient, int a, int b)
+{
+    if (a < 0 || a >= quotient->parts)
+        return 0;
+    for (int i = 0; i < quotient->degree[a]; i++)
+    {
+        if (quotient->adjacent[a][i] == b)
+            return quotient->weights[a][i];
+    }
+    return 0;
+}
+
+// zwraca liczbe przecietych krawedzi wychodzacych z czesci
+int quotient_part_cut(const Quotient_graph *quotient, int part)
+{
+    int cut = 0;
+    for (int i = 0; i < quotient->degree[part]; i++)
+    {
+        cut += quotient->weights[part][i];
+    }
+    return cut;
+}
+
+// wypisuje pary sasiednich czesci z liczba przecietych krawedzi
+void print_quotient_graph(const Quotient_graph *quotient)
+{
+    printf("\nMacierz przeciec miedzy czesciami:\n");
+    for (int p = 0; p < quotient->parts; p++)
+    {
+        for (int i = 0; i < quotient->degree[p]; i++)
+        {
+            int r = quotient->adjacent[p][i];
+            if (p < r)
+                printf("  - Czesci %d i %d: %d krawedzi\n", p, r, quotient->weights[p][i]);
+        }
+    }
+    printf("Wierzcholki graniczne:\n");
+    for (int p = 0; p < quotient->parts; p++)
+    {
+        printf("  - Partycja %d: %d (sasiednie czesci: %d)\n", p, quotient->boundary_count[p], quotient->degree[p]);
+    }
+}
@@ -0,0 +1,63 @@
+#include "random.h"
+#include <time.h>
+
+// stan generatora biezacego watku
+static __thread uint64_t random_state[4];
+static __thread int random_seeded = 0;
+
+// krok splitmix64 - rozwija jedno ziarno na kolejne slowa stanu
+static uint64_t splitmix64(uint64_t *x)
+{
+    uint64_t z = (*x += UINT64_C(0x9E3779B97F4A7C15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+// ustawia ziarno generatora biezacego watku
+void seed_random(uint64_t seed)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        random_state[i] = splitmix64(&seed);
+    }
+    random_seeded = 1;
+}
+
+// nastepna liczba xoshiro256**
+uint64_t next_random(void)
+{
+    // bez ziarna kazdy watek i kazde uruchomienie dostaje inny stan
+    if (!random_seeded)
+        seed_random((uint64_t)time(NULL) ^ (uint64_t)(uintptr_t)&random_seeded);
+
+    uint64_t *s = random_state;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+// liczba z przedzialu [0, bound) metoda mnozenia (Lemire), bez dzielenia modulo
+int random_below(int bound)
+{
+    if (bound <= 0)
+        return 0;
+    return (int)(((next_random() >> 32) * (uint64_t)bound) >> 32);
+}
+
+// liczba z przedzialu [0, 1) z 53 najstarszych bitow
+double random_unit(void)
+{
+    return (next_random() >> 11) * (1.0 / 9007199254740992.0);
+}
@@ -0,0 +1,447 @@
+#include "recursive_bisection.h"
+#include "region_growing.h"
+#include <limits.h>
+
+// podproblem: wierzcholki vertices[start .. start + count - 1] dziela sie na czesci first_part .. first_part + parts - 1
+typedef struct
+{
+    int start;
+    int count;
+    int first_part;
+    int parts;
+    int split; // rozmiar lewej strony po bisekcji
+} Bisection_problem;
+
+// wspolny stan jednego poziomu rekurencji
+typedef struct
+{
+    Graph *graph;
+    int *vertices;
+    int *local; // numer wierzcholka w jego podproblemie, kazde zadanie pisze tylko swoje wierzcholki
+    Bisection_problem *problems;
+    double tolerance; // dopuszczalna nierownowaga jednego poziomu
+} Bisection_level;
+
+// podgraf indukowany podproblemu z numeracja lokalna i stan dwuczesciowego FM
+typedef struct
+{
+    int count;
+    int max_degree;
+    int *offsets;
+    int *adjacency;
+    int *side;        // 0 = lewa, 1 = prawa
+    int *pinned_side; // strona przypietego wierzcholka (-1 = wolny)
+    int *gain;        // o ile zmaleje ciecie po przeniesieniu na druga strone
+    int *next;        // listy kubelkow zysku
+    int *prev;
+    int *moved;
+    int *moves; // kolejnosc ruchow przebiegu, do wycofania
+    int *heads; // poczatki kubelkow [strona][zysk + max_degree]
+    int top[2]; // najwyzszy byc moze niepusty kubelek strony
+} Bisection_graph;
+
+static int *bisection_alloc(size_t count)
+{
+    int *array = malloc((count > 0 ? count : 1) * sizeof(int));
+    if (!array)
+    {
+        perror("Blad alokacji pamieci dla bisekcji rekurencyjnej");
+        exit(EXIT_FAILURE);
+    }
+    return array;
+}
+
+// buduje podgraf indukowany podproblemu, czlonkostwo sasiada rozpoznaje po czesci first_part
+static void build_bisection_graph(const Bisection_level *level, const Bisection_problem *problem, Bisection_graph *b)
+{
+    const Graph *graph = level->graph;
+    const int *vertices = level->vertices + problem->start;
+    int count = problem->count;
+    int right_part = problem->first_part + problem->parts / 2;
+
+    long total = 0;
+    for (int i = 0; i < count; i++)
+    {
+        level->local[vertices[i]] = i;
+        total += graph->nodes[vertices[i]].neighbor_count;
+    }
+
+    b->count = count;
+    b->offsets = bisection_alloc(count + 1);
+    b->adjacency = bisection_alloc(total);
+    b->side = bisection_alloc(count);
+    b->pinned_side = bisection_alloc(count);
+    b->gain = bisection_alloc(count);
+    b->next = bisection_alloc(count);
+    b->prev = bisection_alloc(count);
+    b->moved = bisection_alloc(count);
+    b->moves = bisection_alloc(count);
+
+    int edges = 0;
+    b->max_degree = 0;
+    b->offsets[0] = 0;
+    for (int i = 0; i < count; i++)
+    {
+        int vertex = vertices[i];
+        const Node *node = &graph->nodes[vertex];
+        for (int j = 0; j < node->neighbor_count; j++)
+        {
+            int neighbor = node->neighbors[j];
+            if (neighbor != vertex && get_part_id(graph, neighbor) == problem->first_part)
+                b->adjacency[edges++] = level->local[neighbor];
+        }
+        b->offsets[i + 1] = edges;
+        if (edges - b->offsets[i] > b->max_degree)
+            b->max_degree = edges - b->offsets[i];
+        b->pinned_side[i] = is_pinned(graph, vertex) ? graph->pinned[vertex] >= right_part : -1;
+    }
+    b->heads = bisection_alloc(2 * (2 * b->max_degree + 1));
+}
+
+static void free_bisection_graph(Bisection_graph *b)
+{
+    free(b->offsets);
+    free(b->adjacency);
+    free(b->side);
+    free(b->pinned_side);
+    free(b->gain);
+    free(b->next);
+    free(b->prev);
+    free(b->moved);
+    free(b->moves);
+    free(b->heads);
+}
+
+static inline int *bucket_head(Bisection_graph *b, int side, int gain)
+{
+    return &b->heads[side * (2 * b->max_degree + 1) + gain + b->max_degree];
+}
+
+static void bucket_insert(Bisection_graph *b, int v)
+{
+    int *head = bucket_head(b, b->side[v], b->gain[v]);
+    b->prev[v] = -1;
+    b->next[v] = *head;
+    if (*head != -1)
+        b->prev[*head] = v;
+    *head = v;
+    if (b->gain[v] + b->max_degree > b->top[b->side[v]])
+        b->top[b->side[v]] = b->gain[v] + b->max_degree;
+}
+
+static void bucket_remove(Bisection_graph *b, int v)
+{
+    if (b->prev[v] != -1)
+        b->next[b->prev[v]] = b->next[v];
+    else
+        *bucket_head(b, b->side[v], b->gain[v]) = b->next[v];
+    if (b->next[v] != -1)
+        b->prev[b->next[v]] = b->prev[v];
+}
+
+// wierzcholek strony o najwiekszym zysku albo -1
+static int bucket_top(Bisection_graph *b, int side)
+{
+    while (b->top[side] >= 0 && *bucket_head(b, side, b->top[side] - b->max_degree) == -1)
+        b->top[side]--;
+    return b->top[side] >= 0 ? *bucket_head(b, side, b->top[side] - b->max_degree) : -1;
+}
+
+// kolejnosc BFS wszystkich skladowych zaczynajac od start, zwraca rozmiar skladowej start
+static int breadth_first_order(Bisection_graph *b, int start, int *order)
+{
+    int *seen = b->moved;
+    memset(seen, 0, b->count * sizeof(int));
+    int placed = 0;
+    int first_size = 0;
+    int next_root = 0;
+    int root = start;
+    while (placed < b->count)
+    {
+        if (root == -1)
+        {
+            while (seen[next_root])
+                next_root++;
+            root = next_root;
+        }
+        seen[root] = 1;
+        order[placed++] = root;
+        for (int head = placed - 1; head < placed; head++)
+        {
+            int v = order[head];
+            for (int e = b->offsets[v]; e < b->offsets[v + 1]; e++)
+            {
+                int u = b->adjacency[e];
+                if (!seen[u])
+                {
+                    seen[u] = 1;
+                    order[placed++] = u;
+                }
+            }
+        }
+        if (!first_size)
+            first_size = placed;
+        root = -1;
+    }
+    return first_size;
+}
+
+// podzial startowy: prefiks kolejnosci BFS od wierzcholka peryferyjnego, zwraca rozmiar lewej strony
+static int initial_split(Bisection_graph *b, int left_target)
+{
+    int *order = b->moves;
+    int first_size = breadth_first_order(b, 0, order);
+    breadth_first_order(b, order[first_size - 1], order);
+
+    int left_size = 0;
+    for (int i = 0; i < b->count; i++)
+    {
+        left_size += b->pinned_side[i] == 0;
+    }
+    for (int k = 0; k < b->count; k++)
+    {
+        int v = order[k];
+        if (b->pinned_side[v] >= 0)
+        {
+            b->side[v] = b->pinned_side[v];
+        }
+        else if (left_size < left_target)
+        {
+            b->side[v] = 0;
+            left_size++;
+        }
+        else
+        {
+            b->side[v] = 1;
+        }
+    }
+    return left_size;
+}
+
+// jeden przebieg dwuczesciowego FM, zostaje najlepszy stan z lewa strona w [min_left, max_left]
+// w trakcie przebiegu wolno wyjsc o jeden wierzcholek poza granice, inaczej przy ciasnych granicach
+// zaden ruch nie bylby mozliwy; zwraca nowy rozmiar lewej strony
+static int fm_bisection_pass(Bisection_graph *b, int left_size, int left_target, int min_left, int max_left,
+                             int *improved)
+{
+    for (int i = 0; i < 2 * (2 * b->max_degree + 1); i++)
+    {
+        b->heads[i] = -1;
+    }
+    b->top[0] = -1;
+    b->top[1] = -1;
+    for (int v = 0; v < b->count; v++)
+    {
+        int gain = 0;
+        for (int e = b->offsets[v]; e < b->offsets[v + 1]; e++)
+        {
+            gain += b->side[b->adjacency[e]] != b->side[v] ? 1 : -1;
+        }
+        b->gain[v] = gain;
+        b->moved[v] = 0;
+        if (b->pinned_side[v] < 0)
+            bucket_insert(b, v);
+    }
+
+    int delta = 0;
+    int balanced = left_size >= min_left && left_size <= max_left;
+    int best_delta = balanced ? 0 : INT_MAX;
+    int best_imbalance = abs(left_size - left_target);
+    int best_count = 0;
+    int move_count = 0;
+    int stall = 0;
+    while (1)
+    {
+        int from_left = left_size > min_left - 1 ? bucket_top(b, 0) : -1;
+        int from_right = left_size < max_left + 1 ? bucket_top(b, 1) : -1;
+        int v;
+        if (from_left == -1 && from_right == -1)
+            break;
+        if (from_left == -1)
+            v = from_right;
+        else if (from_right == -1)
+            v = from_left;
+        else if (b->gain[from_left] != b->gain[from_right])
+            v = b->gain[from_left] > b->gain[from_right] ? from_left : from_right;
+        else
+            v = left_size > left_target ? from_left : from_right;
+
+        bucket_remove(b, v);
+        b->moved[v] = 1;
+        b->moves[move_count++] = v;
+        delta -= b->gain[v];
+        int old_side = b->side[v];
+        b->side[v] = 1 - old_side;
+        left_size += old_side == 0 ? -1 : 1;
+
+        // krawedz do sasiada ze starej strony zaczyna byc przecieta, do sasiada z nowej przestaje
+        for (int e = b->offsets[v]; e < b->offsets[v + 1]; e++)
+        {
+            int u = b->adjacency[e];
+            if (b->moved[u] || b->pinned_side[u] >= 0)
+                continue;
+            bucket_remove(b, u);
+            b->gain[u] += b->side[u] == old_side ? 2 : -2;
+            bucket_insert(b, u);
+        }
+
+        int imbalance = abs(left_size - left_target);
+        balanced = left_size >= min_left && left_size <= max_left;
+        if (balanced && (delta < best_delta || (delta == best_delta && imbalance < best_imbalance)))
+        {
+            best_delta = delta;
+            best_imbalance = imbalance;
+            best_count = move_count;
+            stall = 0;
+        }
+        else if (++stall > BISECTION_FM_STALL)
+        {
+            break;
+        }
+    }
+
+    // wycofanie ruchow wykonanych po najlepszym stanie
+    for (int i = move_count - 1; i >= best_count; i--)
+    {
+        int v = b->moves[i];
+        left_size += b->side[v] == 0 ? -1 : 1;
+        b->side[v] = 1 - b->side[v];
+    }
+    *improved = best_count > 0;
+    return left_size;
+}
+
+// bisekcja jednego podproblemu, zadanie puli - pisze tylko swoj segment vertices i swoje wpisy local
+static void bisect_task(void *arg, int task)
+{
+    Bisection_level *level = arg;
+    Bisection_problem *problem = &level->problems[task];
+    int count = problem->count;
+    problem->split = 0;
+    if (count == 0)
+        return;
+
+    // rozmiary stron proporcjonalne do liczby czesci po kazdej stronie
+    int left_parts = problem->parts / 2;
+    int right_parts = problem->parts - left_parts;
+    int left_target = (int)((long long)count * left_parts / problem->parts);
+    int max_left = (int)(left_target * (1.0 + level->tolerance));
+    int min_left = count - (int)((count - left_target) * (1.0 + level->tolerance));
+    // kazda strona potrzebuje przynajmniej wierzcholka na czesc
+    if (min_left < left_parts)
+        min_left = left_parts;
+    if (max_left > count - right_parts)
+        max_left = count - right_parts;
+    if (min_left > max_left)
+    {
+        min_left = left_target;
+        max_left = left_target;
+    }
+
+    Bisection_graph b;
+    build_bisection_graph(level, problem, &b);
+    int left_size = initial_split(&b, left_target);
+    for (int pass = 0; pass < BISECTION_FM_PASSES; pass++)
+    {
+        int improved;
+        left_size = fm_bisection_pass(&b, left_size, left_target, min_left, max_left, &improved);
+        if (!improved)
+            break;
+    }
+
+    // lewa strona na poczatek segmentu, kolejnosc wewnatrz stron zachowana
+    int *vertices = level->vertices + problem->start;
+    int *ordered = b.moves;
+    int left = 0;
+    int right = left_size;
+    for (int i = 0; i < count; i++)
+    {
+        if (b.side[i] == 0)
+            ordered[left++] = vertices[i];
+        else
+            ordered[right++] = vertices[i];
+    }
+    memcpy(vertices, ordered, count * sizeof(int));
+    problem->split = left_size;
+    free_bisection_graph(&b);
+}
+
+// podzial przez rekurencyjna bisekcje
+int recursive_bisection_partition(Graph *graph, int parts, Partition_data *partition_data, float accuracy)
+{
+    if (parts > graph->vertices)
+    {
+        perror("Liczba czesci nie moze byc wieksza od liczby wierzcholkow");
+        exit(EXIT_FAILURE);
+    }
+
+    assing_parts(graph, parts);
+    int n = graph->vertices;
+    int *vertices = bisection_alloc(n);
+    int *local = bisection_alloc(n);
+    int *part_counts = bisection_alloc(parts);
+    Bisection_problem *problems = malloc(parts * sizeof(Bisection_problem));
+    Bisection_problem *next_problems = malloc(parts * sizeof(Bisection_problem));
+    if (!problems || !next_problems)
+    {
+        perror("Blad alokacji pamieci dla bisekcji rekurencyjnej");
+        exit(EXIT_FAILURE);
+    }
+    for (int v = 0; v < n; v++)
+    {
+        vertices[v] = v;
+        set_part_id(graph, v, 0);
+    }
+
+    // nierownowaga kazdego poziomu tak dobrana, zeby po wszystkich poziomach zmiescic sie w dokladnosci
+    int levels = 0;
+    for (int p = 1; p < parts; p *= 2)
+        levels++;
+    Bisection_level level = {graph, vertices, local, problems, levels > 0 ? pow(1.0 + accuracy, 1.0 / levels) - 1.0 : 0.0};
+
+    int count = 0;
+    if (parts > 1)
+        problems[count++] = (Bisection_problem){0, n, 0, parts, 0};
+
+    // poziom po poziomie: podproblemy poziomu sa rozlaczne, wiec ida naraz jako zadania puli
+    Thread_pool *pool = n >= PARALLEL_BFS_MIN_VERTICES ? get_thread_pool() : NULL;
+    while (count > 0)
+    {
+        level.problems = problems;
+        parallel_for(pool, count, bisect_task, &level);
+
+        // prawe strony dostaja swoja pierwsza czesc szeregowo - set_part_id aktualizuje rozmiary czesci
+        int next_count = 0;
+        for (int i = 0; i < count; i++)
+        {
+            const Bisection_problem *problem = &problems[i];
+            int left_parts = problem->parts / 2;
+            int right_parts = problem->parts - left_parts;
+            int right_part = problem->first_part + left_parts;
+            for (int j = problem->split; j < problem->count; j++)
+            {
+                set_part_id(graph, vertices[problem->start + j], right_part);
+            }
+            if (left_parts > 1)
+                next_problems[next_count++] = (Bisection_problem){problem->start, problem->split, problem->first_part, left_parts, 0};
+            if (right_parts > 1)
+                next_problems[next_count++] = (Bisection_problem){problem->start + problem->split, problem->count - problem->split,
+                                                                  right_part, right_parts, 0};
+        }
+
+        Bisection_problem *swap = problems;
+        problems = next_problems;
+        next_problems = swap;
+        count = next_count;
+    }
+
+    memcpy(part_counts, graph->part_sizes, parts * sizeof(int));
+    free(vertices);
+    free(local);
+    free(problems);
+    free(next_problems);
+
+    int success = complete_partition(graph, parts, partition_data, part_counts, accuracy);
+    free(part_counts);
+    return success;
+}
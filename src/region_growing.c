@@ -32,374 +32,473 @@ void remove_from_queue(struct Queue *queue)
     }
 }
 
-// generuje punkty startowe dla partycji, staramy sie zeby byly od siebie oddalone
-int *generate_seed_points(Graph *graph, int parts)
+// sposob wybierania punktow startowych, zmieniany przez set_seeding_mode
+static Seeding_mode seeding_mode = SEEDING_KCENTER;
+
+// ustawia sposob wybierania punktow startowych
+void set_seeding_mode(Seeding_mode mode)
 {
-    srand(time(NULL));
-    int *seed_points = malloc(parts * sizeof(int));
-    if (seed_points == NULL)
-    {
-        perror("Blad alokacji pamieci dla punktow startowych");
-        exit(EXIT_FAILURE);
-    }
+    seeding_mode = mode;
+}
 
-    // losujemy pierwszy punkt
-    seed_points[0] = rand() % graph->vertices;
+// dobiera kolejne punkty z losowych kandydatow, jeden przebieg wielozrodlowego BFS na punkt
+static void pick_sampled_seeds(Graph *graph, int parts, int *seed_points, unsigned char *is_seed)
+{
+    // bufory wielozrodlowego BFS sa wspolne dla wszystkich punktow
+    Msbfs_state *state = create_msbfs_state(graph->vertices);
+    int candidates[SEED_CANDIDATES];
+    int distances[SEED_CANDIDATES];
 
-    // dla kazdego kolejnego punktu szukamy takiego, ktory jest malo polaczony z poprzednimi
-    for (int i = 1; i < parts; i++)
+    // dla kazdego kolejnego punktu wybieramy kandydata najdalej od juz wybranych
+    for (int i = 0; i < parts; i++)
     {
-        int best_vertex = -1;
-        int min_connections = graph->vertices; // maksymalna mozliwa liczba polaczen
+        if (seed_points[i] != -1)
+            continue;
 
-        // sprawdzamy 100 losowych kandydatow
-        for (int j = 0; j < 100; j++)
+        // losujemy kandydatow, jeden przebieg BFS liczy odleglosc kazdego z nich do najblizszego punktu
+        for (int j = 0; j < SEED_CANDIDATES; j++)
         {
-            int candidate = rand() % graph->vertices;
+            candidates[j] = random_below(graph->vertices);
+        }
+        nearest_target_distances(graph, state, candidates, SEED_CANDIDATES, is_seed, distances);
 
-            // liczymy polaczenia z juz wybranymi punktami
-            int connections = 0;
-            for (int k = 0; k < i; k++)
+        int best_vertex = -1;
+        int best_distance = 0;
+        for (int j = 0; j < SEED_CANDIDATES; j++)
+        {
+            // kandydat bez sciezki do punktow lezy w innej skladowej - najlepszy mozliwy
+            int distance = distances[j] < 0 ? graph->vertices : distances[j];
+            if (distance > best_distance)
             {
-                int seed = seed_points[k];
-
-                // sprawdzamy czy jest bezposrednie polaczenie
-                for (int l = 0; l < graph->nodes[candidate].neighbor_count; l++)
-                {
-                    if (graph->nodes[candidate].neighbors[l] == seed)
-                    {
-                        connections++;
-                        break;
-                    }
-                }
+                best_distance = distance;
+                best_vertex = candidates[j];
             }
+        }
 
-            // wybieramy wierzcholek z najmniejsza liczba polaczen
-            if (connections < min_connections)
-            {
-                min_connections = connections;
-                best_vertex = candidate;
-
-                // jesli znalezlismy calkowicie niepodlaczony punkt, to super
-                if (min_connections == 0)
-                    break;
-            }
+        // wszyscy kandydaci sa juz punktami startowymi - bierzemy pierwszy wolny wierzcholek
+        for (int v = 0; best_vertex == -1 && v < graph->vertices; v++)
+        {
+            if (!is_seed[v])
+                best_vertex = v;
         }
 
         seed_points[i] = best_vertex;
+        is_seed[best_vertex] = 1;
     }
 
-    // oznaczamy punkty startowe jako nalezace do odpowiednich partycji
-    for (int i = 0; i < parts; i++)
+    free_msbfs_state(state);
+}
+
+// wierzcholki w kubelkach wedlug odleglosci od najblizszego punktu startowego
+// odleglosci tylko maleja, wiec stare wpisy zostaja w kubelkach i sa pomijane przy odczycie
+typedef struct
+{
+    int *head;         // pierwszy wpis kubelka, ostatni kubelek to wierzcholki nieosiagalne
+    int *entry_vertex; // wierzcholek wpisu
+    int *entry_next;   // nastepny wpis w kubelku
+    int count;         // liczba wpisow
+    int capacity;      // pojemnosc tablic wpisow
+    int max;           // gorne ograniczenie najwiekszej niepustej odleglosci
+} Distance_buckets;
+
+// dodaje wierzcholek do kubelka odleglosci
+static void push_distance(Distance_buckets *buckets, int distance, int vertex)
+{
+    if (buckets->count >= buckets->capacity)
     {
-        graph->nodes[seed_points[i]].part_id = i;
+        buckets->capacity *= 2;
+        buckets->entry_vertex = realloc(buckets->entry_vertex, buckets->capacity * sizeof(int));
+        buckets->entry_next = realloc(buckets->entry_next, buckets->capacity * sizeof(int));
+        if (!buckets->entry_vertex || !buckets->entry_next)
+        {
+            perror("Blad alokacji pamieci dla kubelkow odleglosci");
+            exit(EXIT_FAILURE);
+        }
     }
+    buckets->entry_vertex[buckets->count] = vertex;
+    buckets->entry_next[buckets->count] = buckets->head[distance];
+    buckets->head[distance] = buckets->count++;
+    if (distance > buckets->max)
+        buckets->max = distance;
+}
 
-    return seed_points;
+// BFS od nowego punktu poprawiajacy odleglosci tylko tam, gdzie punkt jest blizej niz poprzednie
+// kazdy wierzcholek jest odwiedzany tylko wtedy, gdy jego odleglosc maleje
+static void relax_distances(const Graph *graph, int source, int *distance, int *queue, Distance_buckets *buckets)
+{
+    int front = 0;
+    int rear = 0;
+    distance[source] = 0;
+    queue[rear++] = source;
+
+    while (front < rear)
+    {
+        int vertex = queue[front++];
+        const Node *node = &graph->nodes[vertex];
+        for (int j = 0; j < node->neighbor_count; j++)
+        {
+            int neighbor = node->neighbors[j];
+            if (distance[vertex] + 1 < distance[neighbor])
+            {
+                distance[neighbor] = distance[vertex] + 1;
+                queue[rear++] = neighbor;
+                if (buckets)
+                    push_distance(buckets, distance[neighbor], neighbor);
+            }
+        }
+    }
 }
 
-// glowny algorytm podzialu grafu metoda rozrostu regionow
-int region_growing(Graph *graph, int parts, Partition_data *partition_data, float accuracy)
+// wierzcholek najdalszy od wszystkich punktow, -1 gdy wszystkie sa punktami
+static int farthest_vertex(Distance_buckets *buckets, const int *distance, const unsigned char *is_seed)
 {
-    // sprawdzamy czy liczba partycji ma sens
-    if (parts > graph->vertices)
+    while (buckets->max >= 0)
     {
-        perror("Liczba czesci nie moze byc wieksza od liczby wierzcholkow");
-        exit(EXIT_FAILURE);
+        int entry = buckets->head[buckets->max];
+        if (entry == -1)
+        {
+            buckets->max--;
+            continue;
+        }
+        int vertex = buckets->entry_vertex[entry];
+        if (distance[vertex] == buckets->max && !is_seed[vertex])
+            return vertex;
+
+        // nieaktualny wpis albo juz wybrany punkt
+        buckets->head[buckets->max] = buckets->entry_next[entry];
     }
+    return -1;
+}
 
-    // inicjalizujemy zmienne
-    int *seed_points = generate_seed_points(graph, parts);
-    int *visited = malloc(graph->vertices * sizeof(int));
+// losuje wierzcholek z prawdopodobienstwem proporcjonalnym do kwadratu odleglosci (jak w k-means++)
+static int sample_squared_distance(const Graph *graph, const int *distance, const unsigned char *is_seed)
+{
+    double total = 0;
+    for (int v = 0; v < graph->vertices; v++)
+    {
+        if (!is_seed[v])
+            total += (double)distance[v] * distance[v];
+    }
+    if (total <= 0)
+        return -1;
 
-    if (visited == NULL)
+    double target = total * random_unit();
+    int last = -1;
+    for (int v = 0; v < graph->vertices; v++)
     {
-        perror("Blad alokacji pamieci dla odwiedzonych wezlow");
-        free(seed_points);
-        exit(EXIT_FAILURE);
+        if (is_seed[v] || distance[v] == 0)
+            continue;
+        last = v;
+        target -= (double)distance[v] * distance[v];
+        if (target < 0)
+            return v;
     }
+    return last;
+}
 
-    // zerujemy tablice odwiedzonych
-    memset(visited, 0, graph->vertices * sizeof(int));
+// znajduje wierzcholek pseudo-peryferyjny: kolejne BFS od najdalszego wierzcholka poprzedniego
+// przejscia, az ekscentrycznosc przestanie rosnac (jak w algorytmie George'a i Liu)
+static int find_pseudo_peripheral(const Graph *graph, int start, int *distance, int *queue)
+{
+    int vertex = start;
+    int eccentricity = -1;
+    for (int sweep = 0; sweep < 8; sweep++)
+    {
+        for (int v = 0; v < graph->vertices; v++)
+            distance[v] = graph->vertices;
+        relax_distances(graph, vertex, distance, queue, NULL);
 
-    // tworzymy tablice frontow dla kazdej partycji
-    int **frontier = malloc(parts * sizeof(int *));
-    int *frontier_size = malloc(parts * sizeof(int));
-    int *frontier_capacity = malloc(parts * sizeof(int));
+        // najdalszy w skladowej startu, przy remisie najmniejszego stopnia
+        int farthest = vertex;
+        for (int v = 0; v < graph->vertices; v++)
+        {
+            if (distance[v] == graph->vertices)
+                continue;
+            if (distance[v] > distance[farthest] ||
+                (distance[v] == distance[farthest] &&
+                 graph->nodes[v].neighbor_count < graph->nodes[farthest].neighbor_count))
+                farthest = v;
+        }
+        if (distance[farthest] <= eccentricity)
+            break;
+        eccentricity = distance[farthest];
+        vertex = farthest;
+    }
+    return vertex;
+}
 
-    if (!frontier || !frontier_size || !frontier_capacity)
+// k-center: kolejny punkt to wierzcholek najdalszy od wszystkich wybranych (albo losowany wedlug D^2)
+// odleglosci do najblizszego punktu sa poprawiane przyrostowo po kazdym nowym punkcie
+static void pick_farthest_seeds(Graph *graph, int parts, int *seed_points, unsigned char *is_seed,
+                                int placed, int squared_sampling)
+{
+    int n = graph->vertices;
+    int *distance = malloc(n * sizeof(int));
+    int *queue = malloc(n * sizeof(int));
+    Distance_buckets buckets;
+    buckets.head = malloc((n + 1) * sizeof(int));
+    buckets.capacity = 2 * n + 1;
+    buckets.entry_vertex = malloc(buckets.capacity * sizeof(int));
+    buckets.entry_next = malloc(buckets.capacity * sizeof(int));
+    if (!distance || !queue || !buckets.head || !buckets.entry_vertex || !buckets.entry_next)
     {
-        perror("Blad alokacji pamieci dla frontow partycji");
-        free(seed_points);
-        free(visited);
+        perror("Blad alokacji pamieci dla punktow startowych");
         exit(EXIT_FAILURE);
     }
 
-    // inicjalizujemy fronty z poczatkowym rozmiarem
-    for (int i = 0; i < parts; i++)
+    // bez przypiec pierwszym punktem jest wierzcholek pseudo-peryferyjny
+    if (placed == 0)
     {
-        frontier_size[i] = 0;
-        frontier_capacity[i] = 10; // startowy rozmiar
-        frontier[i] = malloc(frontier_capacity[i] * sizeof(int));
-        if (!frontier[i])
-        {
-            perror("Blad alokacji pamieci dla frontu partycji");
-            // sprzatamy wczesniej zaalokowane
-            for (int j = 0; j < i; j++)
-            {
-                free(frontier[j]);
-            }
-            free(frontier);
-            free(frontier_size);
-            free(frontier_capacity);
-            free(seed_points);
-            free(visited);
-            exit(EXIT_FAILURE);
-        }
+        seed_points[0] = find_pseudo_peripheral(graph, random_below(n), distance, queue);
+        is_seed[seed_points[0]] = 1;
     }
 
-    // resetujemy przypisania partycji
-    for (int i = 0; i < graph->vertices; i++)
+    // odleglosc n oznacza brak sciezki do punktow, takie wierzcholki leza w ostatnim kubelku
+    for (int d = 0; d <= n; d++)
+        buckets.head[d] = -1;
+    buckets.count = 0;
+    buckets.max = -1;
+    for (int v = 0; v < n; v++)
     {
-        graph->nodes[i].part_id = -1; // -1 oznacza brak przypisania
+        distance[v] = n;
+        push_distance(&buckets, n, v);
     }
-
-    // inicjalizujemy liczniki wierzcholkow w partiach
-    int *part_counts = calloc(parts, sizeof(int));
-    if (!part_counts)
+    for (int v = 0; v < n; v++)
     {
-        perror("Blad alokacji pamieci dla licznikow partycji");
-        // sprzatamy
-        for (int i = 0; i < parts; i++)
-        {
-            free(frontier[i]);
-        }
-        free(frontier);
-        free(frontier_size);
-        free(frontier_capacity);
-        free(seed_points);
-        free(visited);
-        exit(EXIT_FAILURE);
+        if (is_seed[v])
+            relax_distances(graph, v, distance, queue, &buckets);
     }
 
-    // dodajemy punkty startowe do frontow partycji
-    // printf("Seed points: ");
     for (int i = 0; i < parts; i++)
     {
-        // printf("%d ", seed_points[i]);
-        visited[seed_points[i]] = 1;
-        graph->nodes[seed_points[i]].part_id = i;
-        add_partition_data(partition_data, i, seed_points[i]);
-        part_counts[i]++;
+        if (seed_points[i] != -1)
+            continue;
 
-        // dodajemy sasiadow punktu startowego do frontu
-        Node *node = &graph->nodes[seed_points[i]];
-        for (int j = 0; j < node->neighbor_count; j++)
+        int vertex = squared_sampling ? sample_squared_distance(graph, distance, is_seed)
+                                      : farthest_vertex(&buckets, distance, is_seed);
+
+        // wszystkie wierzcholki sa juz punktami albo maja odleglosc 0 - bierzemy pierwszy wolny
+        for (int v = 0; vertex == -1 && v < n; v++)
         {
-            int neighbor = node->neighbors[j];
-            if (!visited[neighbor])
-            {
-                // zwiekszamy pojemnosc frontu jesli potrzeba
-                if (frontier_size[i] >= frontier_capacity[i])
-                {
-                    frontier_capacity[i] *= 2;
-                    frontier[i] = realloc(frontier[i], frontier_capacity[i] * sizeof(int));
-                    if (!frontier[i])
-                    {
-                        perror("Blad realokacji frontu partycji");
-                        exit(EXIT_FAILURE);
-                    }
-                }
-                frontier[i][frontier_size[i]++] = neighbor;
-            }
+            if (!is_seed[v])
+                vertex = v;
         }
+
+        seed_points[i] = vertex;
+        is_seed[vertex] = 1;
+        relax_distances(graph, vertex, distance, queue, &buckets);
     }
-    // printf("\n");
 
-    // wyswietlamy liczbe sasiadow punktow startowych
-    // printf("Neighbor counts: ");
+    free(distance);
+    free(queue);
+    free(buckets.head);
+    free(buckets.entry_vertex);
+    free(buckets.entry_next);
+}
+
+// punkty w srodkach rownych odcinkow krzywej Hilberta - rozlozone rownomiernie po siatce
+// zajety srodek (przypiety wierzcholek) zastepuje nastepny wolny wierzcholek na krzywej
+static void pick_curve_seeds(Graph *graph, int parts, int *seed_points, unsigned char *is_seed, const int *curve)
+{
+    int n = graph->vertices;
     for (int i = 0; i < parts; i++)
     {
-        // printf("seed %d: %d neighbors, ", seed_points[i], graph->nodes[seed_points[i]].neighbor_count);
-    }
-    // printf("\n");
+        if (seed_points[i] != -1)
+            continue;
 
-    // obliczamy srednia liczbe wierzcholkow na partycje
-    float avg_vertices_per_part = (float)graph->vertices / parts;
+        int position = (int)(((long long)2 * i + 1) * n / (2 * parts));
+        while (is_seed[curve[position]])
+            position = (position + 1) % n;
+        seed_points[i] = curve[position];
+        is_seed[curve[position]] = 1;
+    }
+}
 
-    // obliczamy min i max bazujac na dokladnosci
-    int min_vertices_per_part = (int)((avg_vertices_per_part * (1.0 - accuracy)));
-    if ((float)min_vertices_per_part < (avg_vertices_per_part * (1.0 - accuracy)))
+// generuje punkty startowe dla partycji, staramy sie zeby byly od siebie oddalone
+int *generate_seed_points(Graph *graph, int parts)
+{
+    int *seed_points = malloc(parts * sizeof(int));
+    unsigned char *is_seed = calloc(graph->vertices, sizeof(unsigned char));
+    if (seed_points == NULL || is_seed == NULL)
     {
-        min_vertices_per_part += 1;
+        perror("Blad alokacji pamieci dla punktow startowych");
+        exit(EXIT_FAILURE);
     }
-    int max_vertices_per_part = (int)(avg_vertices_per_part * (1.0 + accuracy));
-
-    // printf("Average vertices per part: %.2f (min: %d, max: %d)\n",avg_vertices_per_part, min_vertices_per_part, max_vertices_per_part);
-
-    // glowna petla algorytmu
-    int iterations = 0;
-    int unassigned = graph->vertices - parts; // wszystkie wierzcholki minus punkty startowe
-
-    // optymalizacja - trzymamy liste aktywnych partycji
-    int *active_partitions = malloc(parts * sizeof(int));
-    int active_count = parts; // na poczatku wszystkie sa aktywne
 
+    // przypiety wierzcholek jest wymuszonym punktem startowym swojej czesci
+    // wszystkie przypiete oznaczamy, zeby wolne punkty trafily daleko od nich
+    int placed = 0;
     for (int i = 0; i < parts; i++)
-        active_partitions[i] = i;
-
-    while (unassigned > 0 && iterations < graph->vertices * 2)
     {
-        int min_part = -1;
-        int min_size = graph->vertices;
-
-        // sprawdzamy tylko aktywne partycje
-        for (int idx = 0; idx < active_count; idx++)
+        seed_points[i] = -1;
+    }
+    for (int v = 0; graph->pinned && v < graph->vertices; v++)
+    {
+        int part = graph->pinned[v];
+        if (part < 0)
+            continue;
+        is_seed[v] = 1;
+        if (seed_points[part] == -1)
         {
-            int i = active_partitions[idx];
-            if (frontier_size[i] > 0 && part_counts[i] < max_vertices_per_part)
-            {
-                if (min_part == -1 || part_counts[i] < min_size)
-                {
-                    min_part = i;
-                    min_size = part_counts[i];
-                }
-            }
+            seed_points[part] = v;
+            placed++;
         }
+    }
+
+    // bez wspolrzednych punkty geometryczne zastepuje k-center
+    int *curve = seeding_mode == SEEDING_GEOMETRIC ? hilbert_order(graph) : NULL;
 
-        // jesli partycja staje sie nieaktywna, usuwamy ja z listy
-        if (frontier_size[min_part] == 0)
+    if (curve)
+    {
+        pick_curve_seeds(graph, parts, seed_points, is_seed, curve);
+        free(curve);
+    }
+    else if (seeding_mode == SEEDING_SAMPLED)
+    {
+        // bez przypiec losujemy pierwszy punkt
+        if (placed == 0)
         {
-            for (int idx = 0; idx < active_count; idx++)
-            {
-                if (active_partitions[idx] == min_part)
-                {
-                    active_partitions[idx] = active_partitions[active_count - 1];
-                    active_count--;
-                    break;
-                }
-            }
+            seed_points[0] = random_below(graph->vertices);
+            is_seed[seed_points[0]] = 1;
         }
+        pick_sampled_seeds(graph, parts, seed_points, is_seed);
+    }
+    else
+    {
+        pick_farthest_seeds(graph, parts, seed_points, is_seed, placed, seeding_mode == SEEDING_D2);
+    }
 
-        // wybieramy tylko wierzcholek, ktory ma sasiada w partycji
-        int valid_vertex_found = 0;
-        int current = -1;
+    free(is_seed);
 
-        // sprawdzamy po kolei wierzcholki z frontu
-        for (int i = 0; i < frontier_size[min_part]; i++)
-        {
-            int candidate = frontier[min_part][i];
+    // oznaczamy punkty startowe jako nalezace do odpowiednich partycji
+    for (int i = 0; i < parts; i++)
+    {
+        set_part_id(graph, seed_points[i], i);
+    }
 
-            // sprawdzamy czy kandydat ma sasiada w partycji
-            if (!visited[candidate])
-            {
-                int has_neighbor_in_partition = 0;
-                Node *node = &graph->nodes[candidate];
-
-                for (int j = 0; j < node->neighbor_count; j++)
-                {
-                    int neighbor = node->neighbors[j];
-                    if (graph->nodes[neighbor].part_id == min_part)
-                    {
-                        has_neighbor_in_partition = 1;
-                        break;
-                    }
-                }
-
-                if (has_neighbor_in_partition)
-                {
-                    current = candidate;
-                    valid_vertex_found = 1;
-
-                    // usuwamy go z frontu przez zamiane z ostatnim - szybciej niz przesuwanie
-                    frontier[min_part][i] = frontier[min_part][frontier_size[min_part] - 1];
-                    frontier_size[min_part]--;
-                    break;
-                }
-            }
-        }
+    return seed_points;
+}
+
+// przypisuje punkt startowy do czesci i dodaje jego sasiadow do frontu tej czesci
+// punkt mogl juz trafic do frontu jako sasiad wczesniejszego punktu, wiec usuwamy go ze wszystkich frontow
+static void place_seed(Graph *graph, int vertex, int part, int *visited, int *part_counts, Bucket_queue *queue)
+{
+    bucket_queue_remove(queue, vertex);
+    visited[vertex] = 1;
+    set_part_id(graph, vertex, part);
+    part_counts[part]++;
 
-        // jesli nie znalezlismy odpowiedniego wierzcholka, pomijamy te partycje
-        if (!valid_vertex_found)
+    Node *node = &graph->nodes[vertex];
+    for (int j = 0; j < node->neighbor_count; j++)
+    {
+        int neighbor = node->neighbors[j];
+        if (!visited[neighbor])
         {
-            // reset frontu
-            frontier_size[min_part] = 0;
-            continue;
+            bucket_queue_increment(queue, part, neighbor);
         }
+    }
+}
+
+// przypisuje wierzcholki bez czesci jednym wielozrodlowym BFS od przypisanych sasiadow
+// wierzcholek dostaje czesc sasiada, a przy kilku sasiednich czesciach te najmniejsza
+// wierzcholki bez sciezki do przypisanych trafiaja do najmniejszej czesci razem ze swoja skladowa
+static void sweep_unassigned(Graph *graph, int parts, int *part_counts, const int *targets, int target_count)
+{
+    Traversal_workspace *workspace = get_traversal_workspace(graph->vertices);
+    begin_traversal(workspace);
+    int *queue = workspace->queue;
+    int rear = 0;
 
-        if (!visited[current])
+    // pierwszy front: wierzcholki stykajace sie z juz przypisanymi
+    for (int i = 0; i < target_count; i++)
+    {
+        int vertex = targets[i];
+        const Node *node = &graph->nodes[vertex];
+        for (int j = 0; j < node->neighbor_count; j++)
         {
-            visited[current] = 1;
-            graph->nodes[current].part_id = min_part;
-            add_partition_data(partition_data, min_part, current);
-            part_counts[min_part]++;
-            unassigned--;
-
-            // dodajemy sasiadow do frontu
-            Node *node = &graph->nodes[current];
-            for (int i = 0; i < node->neighbor_count; i++)
+            if (get_part_id(graph, node->neighbors[j]) >= 0)
             {
-                int neighbor = node->neighbors[i];
-
-                // sprawdzamy indeks sasiada
-                if (neighbor < 0 || neighbor >= graph->vertices)
-                {
-                    // printf("ERROR: Invalid neighbor index %d for node %d\n", neighbor, current);
-                    continue;
-                }
-
-                if (!visited[neighbor])
-                {
-                    // dodajemy do frontu, powiekszajac w razie potrzeby
-                    if (frontier_size[min_part] >= frontier_capacity[min_part])
-                    {
-                        frontier_capacity[min_part] *= 2;
-                        frontier[min_part] = realloc(frontier[min_part],
-                                                     frontier_capacity[min_part] * sizeof(int));
-                        if (!frontier[min_part])
-                        {
-                            perror("Blad realokacji frontu partycji");
-                            exit(EXIT_FAILURE);
-                        }
-                    }
-                    frontier[min_part][frontier_size[min_part]++] = neighbor;
-                }
+                mark_visited(workspace, vertex);
+                queue[rear++] = vertex;
+                break;
             }
         }
+    }
 
-        iterations++;
-
-        // co jakis czas sprawdzamy postepy
-        if (iterations % 100 == 0)
+    Part_heap *smallest = NULL;
+    int next_target = 0;
+    int front = 0;
+    while (1)
+    {
+        while (front < rear)
         {
-            // szukamy min i max liczby wierzcholkow
-            int min_count = graph->vertices;
-            int max_count = 0;
+            int vertex = queue[front++];
+            const Node *node = &graph->nodes[vertex];
 
-            for (int i = 0; i < parts; i++)
+            // najmniejsza sasiednia czesc
+            int best_part = -1;
+            for (int j = 0; j < node->neighbor_count; j++)
             {
-                if (part_counts[i] < min_count)
-                    min_count = part_counts[i];
-                if (part_counts[i] > max_count)
-                    max_count = part_counts[i];
+                int part = get_part_id(graph, node->neighbors[j]);
+                if (part >= 0 && (best_part == -1 || part_counts[part] < part_counts[best_part] ||
+                                  (part_counts[part] == part_counts[best_part] && part < best_part)))
+                    best_part = part;
             }
+            set_part_id(graph, vertex, best_part);
+            part_counts[best_part]++;
+            if (smallest)
+                part_heap_update(smallest, best_part);
 
-            // sprawdzamy czy jestesmy juz zbalansowani
-            if (min_count >= min_vertices_per_part && unassigned == 0)
+            for (int j = 0; j < node->neighbor_count; j++)
             {
-                // printf("Good balance achieved, terminating\n");
-                break;
+                int neighbor = node->neighbors[j];
+                if (get_part_id(graph, neighbor) == -1 && mark_visited(workspace, neighbor))
+                    queue[rear++] = neighbor;
             }
         }
+
+        // skladowa bez przypisanych wierzcholkow zaczyna sie od najmniejszej czesci
+        while (next_target < target_count && get_part_id(graph, targets[next_target]) != -1)
+            next_target++;
+        if (next_target == target_count)
+            break;
+
+        if (!smallest)
+        {
+            smallest = create_part_heap(parts, part_counts);
+            for (int p = 0; p < parts; p++)
+                part_heap_push(smallest, p);
+        }
+        int vertex = targets[next_target];
+        int part = part_heap_top(smallest);
+        set_part_id(graph, vertex, part);
+        part_counts[part]++;
+        part_heap_update(smallest, part);
+        mark_visited(workspace, vertex);
+
+        const Node *node = &graph->nodes[vertex];
+        for (int j = 0; j < node->neighbor_count; j++)
+        {
+            int neighbor = node->neighbors[j];
+            if (get_part_id(graph, neighbor) == -1 && mark_visited(workspace, neighbor))
+                queue[rear++] = neighbor;
+        }
     }
 
-    free(active_partitions);
+    free_part_heap(smallest);
+}
+
+// przypisuje wierzcholki pominiete przez rozrost, sprawdza dokladnosc i naprawia spojnosc czesci
+// wspolne zakonczenie rozrostu szeregowego, rownoleglego i podzialu geometrycznego
+int complete_partition(Graph *graph, int parts, Partition_data *partition_data, int *part_counts, float accuracy)
+{
+    float avg_vertices_per_part = (float)graph->vertices / parts;
 
     // sprawdzamy czy zostaly jakies nieprzypisane wierzcholki
     int unassigned_count = 0;
     for (int i = 0; i < graph->vertices; i++)
     {
-        if (graph->nodes[i].part_id == -1)
+        if (get_part_id(graph, i) == -1)
         {
             unassigned_count++;
         }
@@ -411,115 +510,28 @@ int region_growing(Graph *graph, int parts, Partition_data *partition_data, floa
 
         // tworzymy liste nieprzypisanych wierzcholkow
         int *unassigned_vertices = malloc(unassigned_count * sizeof(int));
+        if (unassigned_vertices == NULL)
+        {
+            perror("Blad alokacji pamieci dla nieprzypisanych wierzcholkow");
+            exit(EXIT_FAILURE);
+        }
         int idx = 0;
 
         for (int i = 0; i < graph->vertices; i++)
         {
-            if (graph->nodes[i].part_id == -1)
+            if (get_part_id(graph, i) == -1)
             {
                 unassigned_vertices[idx++] = i;
             }
         }
 
-        // probujemy przyporzadkowac z zachowaniem spojnosci
-        int assigned = 1; // flaga czy cos przypisalismy w tej iteracji
-
-        while (assigned && idx > 0)
-        {
-            assigned = 0;
-
-            // sprawdzamy kazdy nieprzypisany wierzcholek
-            for (int i = 0; i < idx; i++)
-            {
-                int v = unassigned_vertices[i];
-
-                if (graph->nodes[v].part_id != -1)
-                {
-                    // juz przypisany w tej iteracji
-                    continue;
-                }
-
-                Node *node = &graph->nodes[v];
-                int smallest_neighbor_part = -1;
-                int smallest_neighbor_count = graph->vertices;
-
-                // szukamy sasiedniej partycji z najmniejsza liczba wierzcholkow
-                for (int j = 0; j < node->neighbor_count; j++)
-                {
-                    int neighbor = node->neighbors[j];
-
-                    if (neighbor >= 0 && neighbor < graph->vertices &&
-                        graph->nodes[neighbor].part_id != -1)
-                    {
-                        int neighbor_part = graph->nodes[neighbor].part_id;
-
-                        if (part_counts[neighbor_part] < smallest_neighbor_count)
-                        {
-                            smallest_neighbor_count = part_counts[neighbor_part];
-                            smallest_neighbor_part = neighbor_part;
-                        }
-                    }
-                }
-
-                // jesli znalezlismy sasiednia partycje, przypisujemy
-                if (smallest_neighbor_part != -1)
-                {
-                    graph->nodes[v].part_id = smallest_neighbor_part;
-                    add_partition_data(partition_data, smallest_neighbor_part, v);
-                    part_counts[smallest_neighbor_part]++;
-                    assigned = 1;
-
-                    // oznaczamy jako przypisany przez -2
-                    unassigned_vertices[i] = -2;
-                }
-            }
-
-            // usuwamy przypisane wierzcholki z listy
-            int new_idx = 0;
-            for (int i = 0; i < idx; i++)
-            {
-                if (unassigned_vertices[i] != -2)
-                {
-                    unassigned_vertices[new_idx++] = unassigned_vertices[i];
-                }
-            }
-            idx = new_idx;
-        }
-
-        // jesli nadal zostaly nieprzypisane wierzcholki, przypisujemy na sile
-        if (idx > 0)
-        {
-            // printf("Warning: %d vertices couldn't be assigned while maintaining connectivity\n", idx);
-
-            for (int i = 0; i < idx; i++)
-            {
-                int v = unassigned_vertices[i];
-
-                // dajemy do najmniejszej partycji
-                int min_part = 0;
-                for (int j = 1; j < parts; j++)
-                {
-                    if (part_counts[j] < part_counts[min_part])
-                    {
-                        min_part = j;
-                    }
-                }
-
-                graph->nodes[v].part_id = min_part;
-                add_partition_data(partition_data, min_part, v);
-                part_counts[min_part]++;
-            }
-        }
+        // jeden BFS od brzegu przypisanych czesci - kazdy sierota dostaje najmniejsza sasiednia czesc,
+        // a skladowe bez przypisanych sasiadow trafiaja do najmniejszej czesci
+        sweep_unassigned(graph, parts, part_counts, unassigned_vertices, idx);
 
         free(unassigned_vertices);
     }
 
-    // ostrzegamy jesli przekroczono limit iteracji
-    if (iterations >= graph->vertices * 3)
-    {
-        printf("WARNING: Loop terminated due to iteration limit\n");
-    }
-
     // wyswietlamy koncowe rozmiary partycji
     // printf("Final partition sizes: ");
     // for (int i = 0; i < parts; i++)
@@ -549,330 +561,536 @@ int region_growing(Graph *graph, int parts, Partition_data *partition_data, floa
         // printf("Warning: Final partition ratios (min: %.2f, max: %.2f) outside accuracy range (%.2f - %.2f)\n",min_ratio, max_ratio, 1.0 - accuracy, 1.0 + accuracy);
     }
 
-    // weryfikujemy spojnosc i naprawiamy jesli trzeba
-    // printf("\nVerifying partition connectivity...\n");
-    int all_connected = 1;
+    // weryfikujemy spojnosc i naprawiamy jesli trzeba - jedno przejscie dla wszystkich czesci
+    if (repair_partition_connectivity(graph, parts, part_counts) > 0)
+    {
+        printf("Fixed disconnected partitions. Re-verifying connectivity...\n");
+        check_partition_connectivity(graph, parts);
+    }
+
+    // listy czesci odtwarzamy z tablicy przypisan dopiero po naprawie spojnosci
+    rebuild_partition_data(partition_data, graph);
 
-    // sprawdzamy spojnosc dla kazdej partycji
-    for (int p = 0; p < parts; p++)
+    return success;
+}
+
+// glowny algorytm podzialu grafu metoda rozrostu regionow
+int region_growing(Graph *graph, int parts, Partition_data *partition_data, float accuracy)
+{
+    // sprawdzamy czy liczba partycji ma sens
+    if (parts > graph->vertices)
     {
-        int is_connected = verify_partition_connectivity(graph, p);
-        if (!is_connected)
-        {
-            all_connected = 0;
-            // printf("Partition %d is not connected - fixing...\n", p);
-            fix_disconnected_partition(graph, p, part_counts);
-        }
+        perror("Liczba czesci nie moze byc wieksza od liczby wierzcholkow");
+        exit(EXIT_FAILURE);
     }
 
-    if (!all_connected)
+    // ustawiamy liczbe czesci i szerokosc tablicy przypisan
+    assing_parts(graph, parts);
+
+    // inicjalizujemy zmienne
+    int *seed_points = generate_seed_points(graph, parts);
+    int *visited = malloc(graph->vertices * sizeof(int));
+
+    if (visited == NULL)
     {
-        printf("Fixed disconnected partitions. Re-verifying connectivity...\n");
-        check_partition_connectivity(graph, parts);
+        perror("Blad alokacji pamieci dla odwiedzonych wezlow");
+        free(seed_points);
+        exit(EXIT_FAILURE);
     }
 
-    // sprzatanie
-    free(visited);
-    free(seed_points);
-    free(part_counts);
-    for (int i = 0; i < parts; i++)
+    // zerujemy tablice odwiedzonych
+    memset(visited, 0, graph->vertices * sizeof(int));
+
+    // fronty wszystkich partycji w kubelkowej kolejce priorytetowej
+    Bucket_queue *queue = create_bucket_queue(graph->vertices, parts);
+
+    // resetujemy przypisania partycji
+    for (int i = 0; i < graph->vertices; i++)
     {
-        free(frontier[i]);
+        set_part_id(graph, i, -1); // -1 oznacza brak przypisania
     }
-    free(frontier);
-    free(frontier_size);
-    free(frontier_capacity);
 
-    return success;
-}
+    // inicjalizujemy liczniki wierzcholkow w partiach
+    int *part_counts = calloc(parts, sizeof(int));
+    if (!part_counts)
+    {
+        perror("Blad alokacji pamieci dla licznikow partycji");
+        // sprzatamy
+        free_bucket_queue(queue);
+        free(seed_points);
+        free(visited);
+        exit(EXIT_FAILURE);
+    }
 
-// sprawdza spojnosc pojedynczej partycji
-int verify_partition_connectivity(Graph *graph, int part_id)
-{
-    // liczymy wierzcholki w partycji tylko raz
-    int *partition_node_counts = NULL;
-    if (!partition_node_counts)
+    // dodajemy punkty startowe do frontow partycji
+    // printf("Seed points: ");
+    for (int i = 0; i < parts; i++)
     {
-        partition_node_counts = calloc(graph->parts, sizeof(int));
-        // zliczamy wierzcholki w kazdej partycji
-        for (int i = 0; i < graph->vertices; i++)
+        // printf("%d ", seed_points[i]);
+        place_seed(graph, seed_points[i], i, visited, part_counts, queue);
+    }
+    // printf("\n");
+
+    // pozostale przypiete wierzcholki tez sa punktami startowymi swoich czesci
+    for (int v = 0; graph->pinned && v < graph->vertices; v++)
+    {
+        if (graph->pinned[v] >= 0 && !visited[v])
         {
-            if (graph->nodes[i].part_id >= 0 && graph->nodes[i].part_id < graph->parts)
-                partition_node_counts[graph->nodes[i].part_id]++;
+            place_seed(graph, v, graph->pinned[v], visited, part_counts, queue);
         }
     }
 
-    // ilosc wierzcholkow w sprawdzanej partycji
-    int count = partition_node_counts[part_id];
+    // wyswietlamy liczbe sasiadow punktow startowych
+    // printf("Neighbor counts: ");
+    for (int i = 0; i < parts; i++)
+    {
+        // printf("seed %d: %d neighbors, ", seed_points[i], graph->nodes[seed_points[i]].neighbor_count);
+    }
+    // printf("\n");
 
-    // pusta lub z jednym wierzcholkiem jest spojna
-    if (count <= 1)
+    // obliczamy srednia liczbe wierzcholkow na partycje
+    float avg_vertices_per_part = (float)graph->vertices / parts;
+
+    // obliczamy min i max bazujac na dokladnosci
+    int min_vertices_per_part = (int)((avg_vertices_per_part * (1.0 - accuracy)));
+    if ((float)min_vertices_per_part < (avg_vertices_per_part * (1.0 - accuracy)))
     {
-        free(partition_node_counts);
-        return 1;
+        min_vertices_per_part += 1;
     }
+    int max_vertices_per_part = (int)(avg_vertices_per_part * (1.0 + accuracy));
+
+    // printf("Average vertices per part: %.2f (min: %d, max: %d)\n",avg_vertices_per_part, min_vertices_per_part, max_vertices_per_part);
 
-    // przygotowujemy struktury do BFS
-    bool *visited = calloc(graph->vertices, sizeof(bool));
-    int *queue = malloc(graph->vertices * sizeof(int));
+    // glowna petla algorytmu
+    int iterations = 0;
+    int unassigned = graph->vertices; // wszystkie wierzcholki minus punkty startowe i przypiete
+    for (int i = 0; i < parts; i++)
+        unassigned -= part_counts[i];
 
-    if (!visited || !queue)
+    // optymalizacja - aktywne partycje w kopcu wedlug rozmiaru, najmniejsza jest na szczycie
+    // partycja z pustym frontem juz nie urosnie, wiec usuwamy ja gdy trafi na szczyt
+    Part_heap *active_parts = create_part_heap(parts, part_counts);
+    for (int i = 0; i < parts; i++)
     {
-        if (visited)
-            free(visited);
-        if (queue)
-            free(queue);
-        free(partition_node_counts);
-        return 0;
+        if (part_counts[i] < max_vertices_per_part)
+            part_heap_push(active_parts, i);
     }
 
-    // szukamy pierwszego wierzcholka w partycji
-    int start = -1;
-    for (int i = 0; i < graph->vertices; i++)
+    while (unassigned > 0 && iterations < graph->vertices * 2)
     {
-        if (graph->nodes[i].part_id == part_id)
+        int min_part = part_heap_top(active_parts);
+
+        // zadna partycja nie moze juz rosnac, reszte przypisze petla awaryjna
+        if (min_part == -1)
         {
-            start = i;
             break;
         }
-    }
 
-    // robimy BFS z tego wierzcholka
-    int front = 0, rear = 0;
-    queue[rear++] = start;
-    visited[start] = true;
-    int visited_count = 1;
+        if (bucket_queue_size(queue, min_part) == 0)
+        {
+            part_heap_remove(active_parts, min_part);
+            continue;
+        }
 
-    while (front < rear)
-    {
-        int current = queue[front++];
+        // zachlanny rozrost: bierzemy wierzcholek frontu z najwieksza liczba sasiadow w partycji
+        // przypisane wierzcholki znikaja ze wszystkich frontow, wiec kandydat jest zawsze wolny
+        int current = bucket_queue_pop(queue, min_part);
+
+        visited[current] = 1;
+        set_part_id(graph, current, min_part);
+        part_counts[min_part]++;
+        unassigned--;
 
-        // sprawdzamy sasiadow
-        for (int i = 0; i < graph->nodes[current].neighbor_count; i++)
+        // partycja urosla - schodzi w dol kopca albo z niego wypada
+        if (part_counts[min_part] >= max_vertices_per_part)
+            part_heap_remove(active_parts, min_part);
+        else
+            part_heap_update(active_parts, min_part);
+
+        // kazdy wolny sasiad zyskuje jednego sasiada w partycji
+        Node *node = &graph->nodes[current];
+        for (int i = 0; i < node->neighbor_count; i++)
         {
-            int neighbor = graph->nodes[current].neighbors[i];
-            // do kolejki dodajemy tylko sasiadow z tej samej partycji
-            if (graph->nodes[neighbor].part_id == part_id && !visited[neighbor])
+            int neighbor = node->neighbors[i];
+            if (!visited[neighbor])
             {
-                visited[neighbor] = true;
-                queue[rear++] = neighbor;
-                visited_count++;
+                bucket_queue_increment(queue, min_part, neighbor);
             }
         }
+
+        iterations++;
+    }
+
+    free_part_heap(active_parts);
+
+    // ostrzegamy jesli przekroczono limit iteracji
+    if (iterations >= graph->vertices * 3)
+    {
+        printf("WARNING: Loop terminated due to iteration limit\n");
     }
 
+    // przypisujemy reszte, sprawdzamy dokladnosc i naprawiamy spojnosc
+    int success = complete_partition(graph, parts, partition_data, part_counts, accuracy);
+
+    // sprzatanie
     free(visited);
-    free(queue);
-    free(partition_node_counts);
+    free(seed_points);
+    free(part_counts);
+    free_bucket_queue(queue);
 
-    // partycja jest spojna jesli odwiedzilismy wszystkie wierzcholki
-    return (visited_count == count);
+    return success;
 }
 
-// naprawia niespojne partycje
-void fix_disconnected_partition(Graph *graph, int part_id, int *part_counts)
+// odczyt czesci wierzcholka, ktory inne watki moga wlasnie zajmowac
+static inline int load_part_id(const Graph *graph, int vertex)
 {
-    // znajdujemy wszystkie komponenty w partycji
-    bool *visited = calloc(graph->vertices, sizeof(bool));
-    int *component_id = malloc(graph->vertices * sizeof(int));
-    int *component_size = calloc(graph->vertices, sizeof(int));
-    int component_count = 0;
-
-    if (!visited || !component_id || !component_size)
-    {
-        if (visited)
-            free(visited);
-        if (component_id)
-            free(component_id);
-        if (component_size)
-            free(component_size);
-        return;
+    if (graph->part_id_width == 1)
+    {
+        uint8_t part = __atomic_load_n(&((uint8_t *)graph->part_ids)[vertex], __ATOMIC_RELAXED);
+        return part == PART_ID_UNASSIGNED_U8 ? -1 : part;
     }
+    if (graph->part_id_width == 2)
+    {
+        uint16_t part = __atomic_load_n(&((uint16_t *)graph->part_ids)[vertex], __ATOMIC_RELAXED);
+        return part == PART_ID_UNASSIGNED_U16 ? -1 : part;
+    }
+    return __atomic_load_n(&((int32_t *)graph->part_ids)[vertex], __ATOMIC_RELAXED);
+}
 
-    // przechodzimy przez wierzcholki partycji
-    for (int i = 0; i < graph->vertices; i++)
+// zajmuje wolny wierzcholek dla czesci jedna operacja compare-and-swap na tablicy przypisan
+// zwraca 1 gdy wierzcholek byl wolny, rozmiary czesci w grafie przelicza sie po rozroscie
+static inline int claim_vertex(Graph *graph, int vertex, int part)
+{
+    if (graph->part_id_width == 1)
+    {
+        uint8_t expected = PART_ID_UNASSIGNED_U8;
+        return __atomic_compare_exchange_n(&((uint8_t *)graph->part_ids)[vertex], &expected, (uint8_t)part, 0,
+                                           __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    }
+    if (graph->part_id_width == 2)
     {
-        if (graph->nodes[i].part_id == part_id && !visited[i])
+        uint16_t expected = PART_ID_UNASSIGNED_U16;
+        return __atomic_compare_exchange_n(&((uint16_t *)graph->part_ids)[vertex], &expected, (uint16_t)part, 0,
+                                           __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    }
+    int32_t expected = -1;
+    return __atomic_compare_exchange_n(&((int32_t *)graph->part_ids)[vertex], &expected, (int32_t)part, 0,
+                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+// front czesci w rozroscie rownoleglym - kolejka FIFO, w jednej rundzie uzywa jej tylko jeden watek
+typedef struct
+{
+    int *items;   // wierzcholki frontu
+    int head;     // pierwszy nieprzetworzony wierzcholek
+    int size;     // liczba wierzcholkow w tablicy
+    int capacity; // pojemnosc tablicy
+} Grow_frontier;
+
+// dopisuje wolnych sasiadow wierzcholka na koniec frontu
+static void push_free_neighbors(const Graph *graph, Grow_frontier *frontier, int vertex)
+{
+    const Node *node = &graph->nodes[vertex];
+
+    // przetworzony poczatek zwalniamy zanim powiekszymy tablice
+    if (frontier->size + node->neighbor_count > frontier->capacity && frontier->head > 0)
+    {
+        memmove(frontier->items, frontier->items + frontier->head, (frontier->size - frontier->head) * sizeof(int));
+        frontier->size -= frontier->head;
+        frontier->head = 0;
+    }
+    if (frontier->size + node->neighbor_count > frontier->capacity)
+    {
+        int capacity = frontier->capacity > 0 ? frontier->capacity : 16;
+        while (capacity < frontier->size + node->neighbor_count)
+            capacity *= 2;
+        int *items = realloc(frontier->items, capacity * sizeof(int));
+        if (!items)
         {
-            // znalezlismy nowy komponent
-            int *queue = malloc(graph->vertices * sizeof(int));
-            if (!queue)
-            {
-                free(visited);
-                free(component_id);
-                free(component_size);
-                return;
-            }
+            perror("Blad realokacji frontu partycji");
+            exit(EXIT_FAILURE);
+        }
+        frontier->items = items;
+        frontier->capacity = capacity;
+    }
 
-            // BFS dla tego komponentu
-            int front = 0, rear = 0;
-            queue[rear++] = i;
-            visited[i] = true;
-            component_id[i] = component_count;
-            component_size[component_count]++;
+    for (int j = 0; j < node->neighbor_count; j++)
+    {
+        int neighbor = node->neighbors[j];
+        if (load_part_id(graph, neighbor) == -1)
+            frontier->items[frontier->size++] = neighbor;
+    }
+}
 
-            while (front < rear)
-            {
-                int current = queue[front++];
-
-                for (int j = 0; j < graph->nodes[current].neighbor_count; j++)
-                {
-                    int neighbor = graph->nodes[current].neighbors[j];
-                    if (graph->nodes[neighbor].part_id == part_id && !visited[neighbor])
-                    {
-                        visited[neighbor] = true;
-                        queue[rear++] = neighbor;
-                        component_id[neighbor] = component_count;
-                        component_size[component_count]++;
-                    }
-                }
-            }
+// dane wspolne dla zadan rozrostu rownoleglego
+typedef struct
+{
+    Graph *graph;
+    Grow_frontier *frontiers; // front kazdej czesci
+    int *part_counts;         // rozmiar kazdej czesci, zmieniany tylko przez zadanie tej czesci
+    int *budget;              // ile wierzcholkow czesc moze zajac w biezacej rundzie
+} Parallel_grow_job;
+
+// zadanie puli - jedna runda rozrostu jednej czesci
+static void grow_part_task(void *arg, int part)
+{
+    Parallel_grow_job *job = arg;
+    Grow_frontier *frontier = &job->frontiers[part];
+    int budget = job->budget[part];
 
-            free(queue);
-            component_count++;
-        }
+    while (budget > 0 && frontier->head < frontier->size)
+    {
+        int vertex = frontier->items[frontier->head++];
+
+        // wierzcholek mogla juz zajac inna czesc, wtedy CAS sie nie udaje
+        if (!claim_vertex(job->graph, vertex, part))
+            continue;
+        job->part_counts[part]++;
+        budget--;
+        push_free_neighbors(job->graph, frontier, vertex);
     }
+}
 
-    // zostawiamy najwiekszy komponent, reszta idzie do innych partycji
-    int largest_component = 0;
-    for (int i = 1; i < component_count; i++)
+// rownolegla wersja rozrostu regionow - wszystkie czesci rosna naraz na puli watkow
+int parallel_region_growing(Graph *graph, int parts, Partition_data *partition_data, float accuracy)
+{
+    if (parts > graph->vertices)
     {
-        if (component_size[i] > component_size[largest_component])
-        {
-            largest_component = i;
-        }
+        perror("Liczba czesci nie moze byc wieksza od liczby wierzcholkow");
+        exit(EXIT_FAILURE);
+    }
+
+    assing_parts(graph, parts);
+    int *seed_points = generate_seed_points(graph, parts);
+
+    int *part_counts = calloc(parts, sizeof(int));
+    int *budget = malloc(parts * sizeof(int));
+    Grow_frontier *frontiers = calloc(parts, sizeof(Grow_frontier));
+    if (!part_counts || !budget || !frontiers)
+    {
+        perror("Blad alokacji pamieci dla rozrostu rownoleglego");
+        exit(EXIT_FAILURE);
     }
 
-    // przepisujemy pozostale komponenty do najblizszych partycji
+    // punkty startowe i przypiete wierzcholki zajmujemy przed startem watkow
     for (int i = 0; i < graph->vertices; i++)
     {
-        if (graph->nodes[i].part_id == part_id && component_id[i] != largest_component)
+        set_part_id(graph, i, -1);
+    }
+    for (int i = 0; i < parts; i++)
+    {
+        set_part_id(graph, seed_points[i], i);
+        part_counts[i]++;
+    }
+    for (int v = 0; graph->pinned && v < graph->vertices; v++)
+    {
+        if (graph->pinned[v] >= 0 && get_part_id(graph, v) == -1)
         {
-            // szukamy sasiedniej partycji
-            int best_part = -1;
-            Node *node = &graph->nodes[i];
+            set_part_id(graph, v, graph->pinned[v]);
+            part_counts[graph->pinned[v]]++;
+        }
+    }
+    for (int v = 0; v < graph->vertices; v++)
+    {
+        int part = get_part_id(graph, v);
+        if (part >= 0)
+            push_free_neighbors(graph, &frontiers[part], v);
+    }
 
-            for (int j = 0; j < node->neighbor_count; j++)
-            {
-                int neighbor = node->neighbors[j];
-                int neighbor_part = graph->nodes[neighbor].part_id;
-
-                if (neighbor_part != part_id && neighbor_part != -1)
-                {
-                    if (best_part == -1 || part_counts[neighbor_part] < part_counts[best_part])
-                    {
-                        best_part = neighbor_part;
-                    }
-                }
-            }
+    float avg_vertices_per_part = (float)graph->vertices / parts;
+    int max_vertices_per_part = (int)(avg_vertices_per_part * (1.0 + accuracy));
 
-            // jesli znalezlismy sasiednia partycje, przypisujemy
-            if (best_part != -1)
-            {
-                part_counts[part_id]--;
-                part_counts[best_part]++;
-                graph->nodes[i].part_id = best_part;
-            }
+    // kontroler rownowagi: w kazdej rundzie czesc moze urosnac o krok, ale nie ponad limit
+    // rundy rozdziela bariera parallel_for, wiec czesci rosna w podobnym tempie
+    int step = max_vertices_per_part / 64 > 0 ? max_vertices_per_part / 64 : 1;
+    Parallel_grow_job job = {graph, frontiers, part_counts, budget};
+    Thread_pool *pool = graph->vertices >= PARALLEL_BFS_MIN_VERTICES ? get_thread_pool() : NULL;
+
+    while (1)
+    {
+        int growing = 0;
+        for (int p = 0; p < parts; p++)
+        {
+            int room = max_vertices_per_part - part_counts[p];
+            budget[p] = frontiers[p].head < frontiers[p].size && room > 0 ? (room < step ? room : step) : 0;
+            if (budget[p] > 0)
+                growing = 1;
         }
+        if (!growing)
+            break;
+        parallel_for(pool, parts, grow_part_task, &job);
     }
 
-    free(visited);
-    free(component_id);
-    free(component_size);
+    // CAS nie aktualizuje rozmiarow czesci w grafie, przeliczamy je raz
+    memset(graph->part_sizes, 0, parts * sizeof(int));
+    for (int v = 0; v < graph->vertices; v++)
+    {
+        int part = get_part_id(graph, v);
+        if (part >= 0)
+            graph->part_sizes[part]++;
+    }
+
+    for (int p = 0; p < parts; p++)
+    {
+        free(frontiers[p].items);
+    }
+    free(frontiers);
+    free(budget);
+
+    int success = complete_partition(graph, parts, partition_data, part_counts, accuracy);
+
+    free(seed_points);
+    free(part_counts);
+    return success;
 }
 
-// sprawdza spojnosc wszystkich partycji w grafie
-void check_partition_connectivity(Graph *graph, int parts)
+// sprawdza spojnosc pojedynczej partycji
+int verify_partition_connectivity(Graph *graph, int part_id)
 {
-    // printf("\n--- Checking partition connectivity ---\n");
-    int all_connected = 1;
+    // ilosc wierzcholkow w sprawdzanej partycji jest utrzymywana w grafie
+    int count = graph->part_sizes[part_id];
+
+    // pusta lub z jednym wierzcholkiem jest spojna
+    if (count <= 1)
+    {
+        return 1;
+    }
 
-    // alokujemy struktury tylko raz dla wszystkich partycji
-    bool *visited = calloc(graph->vertices, sizeof(bool));
-    int *queue = malloc(graph->vertices * sizeof(int));
+    // robimy BFS od pierwszego wierzcholka partycji na buforze watku
+    Traversal_workspace *workspace = get_traversal_workspace(graph->vertices);
+    begin_traversal(workspace);
+    int start = find_part_vertex(graph, part_id, -1);
+    int visited_count = bfs_within_part(graph, workspace, start, part_id, -1);
+
+    // partycja jest spojna jesli odwiedzilismy wszystkie wierzcholki
+    return (visited_count == count);
+}
 
-    if (!visited || !queue)
+// korzen zbioru w strukturze union-find z kompresja sciezki przez polowienie
+static inline int find_root(int *parent, int vertex)
+{
+    while (parent[vertex] != vertex)
     {
-        // printf("Failed to allocate memory for connectivity check\n");
-        if (visited)
-            free(visited);
-        if (queue)
-            free(queue);
-        return;
+        parent[vertex] = parent[parent[vertex]];
+        vertex = parent[vertex];
     }
+    return vertex;
+}
 
-    // sprawdzamy kazda partycje po kolei
-    for (int p = 0; p < parts; p++)
+// laczy zbiory dwoch wierzcholkow, mniejszy doklejamy do wiekszego
+static inline void union_sets(int *parent, int *size, int a, int b)
+{
+    a = find_root(parent, a);
+    b = find_root(parent, b);
+    if (a == b)
+        return;
+    if (size[a] < size[b])
     {
-        // zerujemy tablice odwiedzonych dla nowej partycji
-        memset(visited, 0, graph->vertices * sizeof(bool));
+        int swap = a;
+        a = b;
+        b = swap;
+    }
+    parent[b] = a;
+    size[a] += size[b];
+}
 
-        // liczymy ile wierzcholkow jest w tej partycji
-        int vertices_in_part = 0;
-        int vertices_visited = 0;
+// naprawia spojnosc wszystkich czesci naraz
+int repair_partition_connectivity(Graph *graph, int parts, int *part_counts)
+{
+    int n = graph->vertices;
+    int *parent = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *size = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *largest = malloc((parts > 0 ? parts : 1) * sizeof(int));
+    if (!parent || !size || !largest)
+    {
+        perror("Blad alokacji pamieci dla naprawy spojnosci");
+        exit(EXIT_FAILURE);
+    }
 
-        for (int i = 0; i < graph->vertices; i++)
+    // jedno przejscie po krawedziach laczy konce nalezace do tej samej czesci
+    for (int v = 0; v < n; v++)
+    {
+        parent[v] = v;
+        size[v] = 1;
+    }
+    for (int v = 0; v < n; v++)
+    {
+        int part = get_part_id(graph, v);
+        if (part < 0)
+            continue;
+        const Node *node = &graph->nodes[v];
+        for (int j = 0; j < node->neighbor_count; j++)
         {
-            if (graph->nodes[i].part_id == p)
-                vertices_in_part++;
+            int neighbor = node->neighbors[j];
+            if (v < neighbor && get_part_id(graph, neighbor) == part)
+                union_sets(parent, size, v, neighbor);
         }
+    }
 
-        // jesli partycja ma 0 lub 1 wierzcholek, jest spojna
-        if (vertices_in_part <= 1)
-        {
-            // printf("Partition %d: CONNECTED (visited %d/%d vertices)\n",p, vertices_in_part, vertices_in_part);
+    // najwieksza skladowa kazdej czesci
+    for (int p = 0; p < parts; p++)
+        largest[p] = -1;
+    for (int v = 0; v < n; v++)
+    {
+        int part = get_part_id(graph, v);
+        if (part < 0)
             continue;
-        }
-
-        // szukamy pierwszego wierzcholka w partycji
-        int start_vertex = -1;
-        for (int i = 0; i < graph->vertices; i++)
-        {
-            if (graph->nodes[i].part_id == p)
-            {
-                start_vertex = i;
-                break;
-            }
-        }
+        int root = find_root(parent, v);
+        if (largest[part] == -1 || size[root] > size[largest[part]])
+            largest[part] = root;
+    }
 
-        // BFS rozpoczynajac od znalezionego wierzcholka
-        int front = 0, rear = 0;
-        queue[rear++] = start_vertex;
-        visited[start_vertex] = true;
-        vertices_visited = 1;
+    // skladowa z przypietym wierzcholkiem tez zostaje w swojej czesci
+    for (int v = 0; graph->pinned && v < n; v++)
+    {
+        if (is_pinned(graph, v))
+            size[find_root(parent, v)] = -1;
+    }
 
-        while (front < rear)
-        {
-            int current = queue[front++];
+    // pelna kompresja sciezek - parent[v] to od teraz korzen skladowej v
+    for (int v = 0; v < n; v++)
+    {
+        parent[v] = find_root(parent, v);
+    }
 
-            for (int i = 0; i < graph->nodes[current].neighbor_count; i++)
-            {
-                int neighbor = graph->nodes[current].neighbors[i];
+    // pozostale skladowe zdejmujemy z czesci, korzen v czytamy przed zapisem na pozycje <= v,
+    // wiec parent moze sluzyc za liste
+    int *stranded = parent;
+    int stranded_count = 0;
+    for (int v = 0; v < n; v++)
+    {
+        int part = get_part_id(graph, v);
+        if (part < 0)
+            continue;
+        int root = parent[v];
+        if (root != largest[part] && size[root] != -1)
+            stranded[stranded_count++] = v;
+    }
+    for (int i = 0; i < stranded_count; i++)
+    {
+        part_counts[get_part_id(graph, stranded[i])]--;
+        set_part_id(graph, stranded[i], -1);
+    }
 
-                // dodajemy do kolejki tylko sasiadow z tej samej partycji
-                if (graph->nodes[neighbor].part_id == p && !visited[neighbor])
-                {
-                    visited[neighbor] = true;
-                    queue[rear++] = neighbor;
-                    vertices_visited++;
-                }
-            }
-        }
+    if (stranded_count > 0)
+        sweep_unassigned(graph, parts, part_counts, stranded, stranded_count);
 
-        // sprawdzamy czy wszystkie wierzcholki partycji zostaly odwiedzone
-        int is_connected = (vertices_visited == vertices_in_part);
+    free(parent);
+    free(size);
+    free(largest);
+    return stranded_count;
+}
 
-        // printf("Partition %d: %s (visited %d/%d vertices)\n", p, is_connected ? "CONNECTED" : "DISCONNECTED", vertices_visited, vertices_in_part);
+// sprawdza spojnosc wszystkich partycji w grafie
+void check_partition_connectivity(Graph *graph, int parts)
+{
+    // printf("\n--- Checking partition connectivity ---\n");
 
-        if (!is_connected)
-            all_connected = 0;
-    }
+    // jedno przejscie zliczajace i rownolegly BFS dla wszystkich partycji
+    int all_connected = check_all_parts_connected(graph, parts, NULL);
 
     // podsumowanie
     // printf("Overall partition connectivity: %s\n", all_connected ? "VALID" : "INVALID");
     // printf("--- End of connectivity check ---\n");
-
-    // zwalniamy pamiec
-    free(visited);
-    free(queue);
-}
\ No newline at end of file
+    (void)all_connected;
+}
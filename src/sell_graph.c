@@ -0,0 +1,308 @@
+#include "sell_graph.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// para (stopien, wierzcholek) do sortowania w oknach sigma
+typedef struct
+{
+    int degree;
+    int vertex;
+} Sell_row;
+
+// sortuje malejaco wedlug stopnia, przy rownych stopniach rosnaco wedlug numeru
+static int compare_rows(const void *a, const void *b)
+{
+    const Sell_row *x = a;
+    const Sell_row *y = b;
+    if (x->degree != y->degree)
+        return (x->degree < y->degree) - (x->degree > y->degree);
+    return (x->vertex > y->vertex) - (x->vertex < y->vertex);
+}
+
+// buduje uklad SELL-C-sigma
+Sell_graph *build_sell_graph(const Graph *graph)
+{
+    Sell_graph *sell = calloc(1, sizeof(Sell_graph));
+    Sell_row *rows = malloc((graph->vertices > 0 ? graph->vertices : 1) * sizeof(Sell_row));
+    if (!sell || !rows)
+    {
+        perror("Blad alokacji pamieci dla ukladu SELL");
+        exit(EXIT_FAILURE);
+    }
+
+    // sortujemy wierzcholki wedlug stopnia w oknach sigma
+    for (int i = 0; i < graph->vertices; i++)
+    {
+        rows[i].degree = graph->nodes[i].neighbor_count;
+        rows[i].vertex = i;
+    }
+    for (int start = 0; start < graph->vertices; start += SELL_SIGMA)
+    {
+        int count = graph->vertices - start < SELL_SIGMA ? graph->vertices - start : SELL_SIGMA;
+        qsort(rows + start, count, sizeof(Sell_row), compare_rows);
+    }
+
+    sell->vertices = graph->vertices;
+    sell->slices = (graph->vertices + SELL_CHUNK - 1) / SELL_CHUNK;
+    int padded_rows = sell->slices * SELL_CHUNK;
+    sell->slice_offsets = malloc((sell->slices + 1) * sizeof(int));
+    sell->slice_widths = malloc((sell->slices > 0 ? sell->slices : 1) * sizeof(int));
+    sell->row_vertex = malloc((padded_rows > 0 ? padded_rows : 1) * sizeof(int));
+    sell->row_degree = malloc((padded_rows > 0 ? padded_rows : 1) * sizeof(int));
+    if (!sell->slice_offsets || !sell->slice_widths || !sell->row_vertex || !sell->row_degree)
+    {
+        perror("Blad alokacji pamieci dla ukladu SELL");
+        exit(EXIT_FAILURE);
+    }
+
+    // wiersze dopelnienia ostatniego plastra nie maja wierzcholka ani sasiadow
+    for (int r = 0; r < padded_rows; r++)
+    {
+        sell->row_vertex[r] = r < graph->vertices ? rows[r].vertex : -1;
+        sell->row_degree[r] = r < graph->vertices ? rows[r].degree : 0;
+    }
+    free(rows);
+
+    // szerokosc plastra to najwiekszy stopien jego wierszy
+    sell->slice_offsets[0] = 0;
+    for (int s = 0; s < sell->slices; s++)
+    {
+        int width = 0;
+        for (int lane = 0; lane < SELL_CHUNK; lane++)
+        {
+            if (sell->row_degree[s * SELL_CHUNK + lane] > width)
+                width = sell->row_degree[s * SELL_CHUNK + lane];
+        }
+        sell->slice_widths[s] = width;
+        sell->slice_offsets[s + 1] = sell->slice_offsets[s] + width * SELL_CHUNK;
+    }
+    sell->padded_entries = sell->slice_offsets[sell->slices];
+
+    // kopiujemy sasiadow kolumnami, dopelnienie wskazuje poprawny wierzcholek, zeby gather byl bezpieczny
+    sell->columns = malloc((sell->padded_entries > 0 ? sell->padded_entries : 1) * sizeof(int));
+    if (!sell->columns)
+    {
+        perror("Blad alokacji pamieci dla ukladu SELL");
+        exit(EXIT_FAILURE);
+    }
+    for (int s = 0; s < sell->slices; s++)
+    {
+        for (int lane = 0; lane < SELL_CHUNK; lane++)
+        {
+            int row = s * SELL_CHUNK + lane;
+            int vertex = sell->row_vertex[row];
+            for (int j = 0; j < sell->slice_widths[s]; j++)
+            {
+                int *slot = &sell->columns[sell->slice_offsets[s] + j * SELL_CHUNK + lane];
+                if (j < sell->row_degree[row])
+                    *slot = graph->nodes[vertex].neighbors[j];
+                else
+                    *slot = vertex >= 0 ? vertex : 0;
+            }
+        }
+    }
+
+    return sell;
+}
+
+// buduje uklad tylko dla grafow o rownym rozkladzie stopni
+Sell_graph *build_sell_graph_if_suitable(const Graph *graph)
+{
+    if (graph->vertices <= 0)
+        return NULL;
+
+    double sum = 0.0, sum_squares = 0.0;
+    for (int i = 0; i < graph->vertices; i++)
+    {
+        double degree = graph->nodes[i].neighbor_count;
+        sum += degree;
+        sum_squares += degree * degree;
+    }
+    double mean = sum / graph->vertices;
+    double variance = sum_squares / graph->vertices - mean * mean;
+
+    // przy duzym rozrzucie stopni dopelnienie plastrow zjada zysk z SIMD
+    if (mean <= 0.0 || variance > SELL_MAX_DISPERSION * mean)
+        return NULL;
+
+    return build_sell_graph(graph);
+}
+
+// zwalnia uklad
+void free_sell_graph(Sell_graph *sell)
+{
+    if (!sell)
+        return;
+    free(sell->slice_offsets);
+    free(sell->slice_widths);
+    free(sell->row_vertex);
+    free(sell->row_degree);
+    free(sell->columns);
+    free(sell);
+}
+
+#if defined(__AVX512F__)
+// pobiera przypisania 16 wierzcholkow, skala gather musi byc stala kompilacji
+static inline __m512i gather_parts(const Graph *graph, __mmask16 lanes, __m512i index)
+{
+    __m512i parts;
+    if (graph->part_id_width == 1)
+        parts = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), lanes, index, graph->part_ids, 1);
+    else if (graph->part_id_width == 2)
+        parts = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), lanes, index, graph->part_ids, 2);
+    else
+        return _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), lanes, index, graph->part_ids, 4);
+    return _mm512_and_si512(parts, _mm512_set1_epi32(graph->part_id_width == 1 ? 0xFF : 0xFFFF));
+}
+
+// stopnie wewnetrzne - wersja AVX-512, caly plaster w jednym rejestrze
+void sell_internal_degrees(const Graph *graph, const Sell_graph *sell, int *internal)
+{
+    int counts[SELL_CHUNK];
+    for (int s = 0; s < sell->slices; s++)
+    {
+        const int *columns = sell->columns + sell->slice_offsets[s];
+        __m512i rows = _mm512_loadu_si512(sell->row_vertex + s * SELL_CHUNK);
+        __m512i degree = _mm512_loadu_si512(sell->row_degree + s * SELL_CHUNK);
+        __mmask16 valid_rows = _mm512_cmpge_epi32_mask(rows, _mm512_setzero_si512());
+        __m512i row_parts = gather_parts(graph, valid_rows, rows);
+        __m512i count = _mm512_setzero_si512();
+
+        for (int j = 0; j < sell->slice_widths[s]; j++)
+        {
+            __mmask16 lanes = _mm512_cmpgt_epi32_mask(degree, _mm512_set1_epi32(j));
+            __m512i index = _mm512_loadu_si512(columns + j * SELL_CHUNK);
+            __m512i parts = gather_parts(graph, lanes, index);
+            __mmask16 same = _mm512_mask_cmpeq_epi32_mask(lanes, parts, row_parts);
+            count = _mm512_mask_add_epi32(count, same, count, _mm512_set1_epi32(1));
+        }
+
+        _mm512_storeu_si512(counts, count);
+        for (int lane = 0; lane < SELL_CHUNK; lane++)
+        {
+            int vertex = sell->row_vertex[s * SELL_CHUNK + lane];
+            if (vertex >= 0)
+                internal[vertex] = counts[lane];
+        }
+    }
+}
+#elif defined(__AVX2__)
+// pobiera przypisania 8 wierzcholkow pod maska
+static inline __m256i gather_parts(const Graph *graph, __m256i lanes, __m256i index)
+{
+    const int *base = (const int *)graph->part_ids;
+    __m256i parts;
+    if (graph->part_id_width == 1)
+        parts = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), base, index, lanes, 1);
+    else if (graph->part_id_width == 2)
+        parts = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), base, index, lanes, 2);
+    else
+        return _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), base, index, lanes, 4);
+    return _mm256_and_si256(parts, _mm256_set1_epi32(graph->part_id_width == 1 ? 0xFF : 0xFFFF));
+}
+
+// stopnie wewnetrzne - wersja AVX2, caly plaster w jednym rejestrze
+void sell_internal_degrees(const Graph *graph, const Sell_graph *sell, int *internal)
+{
+    int counts[SELL_CHUNK];
+    for (int s = 0; s < sell->slices; s++)
+    {
+        const int *columns = sell->columns + sell->slice_offsets[s];
+        __m256i rows = _mm256_loadu_si256((const __m256i *)(sell->row_vertex + s * SELL_CHUNK));
+        __m256i degree = _mm256_loadu_si256((const __m256i *)(sell->row_degree + s * SELL_CHUNK));
+        __m256i valid_rows = _mm256_cmpgt_epi32(rows, _mm256_set1_epi32(-1));
+        __m256i row_parts = gather_parts(graph, valid_rows, rows);
+        __m256i count = _mm256_setzero_si256();
+
+        for (int j = 0; j < sell->slice_widths[s]; j++)
+        {
+            __m256i lanes = _mm256_cmpgt_epi32(degree, _mm256_set1_epi32(j));
+            __m256i index = _mm256_loadu_si256((const __m256i *)(columns + j * SELL_CHUNK));
+            __m256i parts = gather_parts(graph, lanes, index);
+            __m256i same = _mm256_and_si256(_mm256_cmpeq_epi32(parts, row_parts), lanes);
+            count = _mm256_sub_epi32(count, same); // same ma -1 w trafionych liniach
+        }
+
+        _mm256_storeu_si256((__m256i *)counts, count);
+        for (int lane = 0; lane < SELL_CHUNK; lane++)
+        {
+            int vertex = sell->row_vertex[s * SELL_CHUNK + lane];
+            if (vertex >= 0)
+                internal[vertex] = counts[lane];
+        }
+    }
+}
+#else
+// stopnie wewnetrzne - wersja skalarna, ten sam porzadek przejscia co wersje SIMD
+void sell_internal_degrees(const Graph *graph, const Sell_graph *sell, int *internal)
+{
+    for (int s = 0; s < sell->slices; s++)
+    {
+        const int *columns = sell->columns + sell->slice_offsets[s];
+        int counts[SELL_CHUNK] = {0};
+        int row_parts[SELL_CHUNK];
+        for (int lane = 0; lane < SELL_CHUNK; lane++)
+        {
+            int vertex = sell->row_vertex[s * SELL_CHUNK + lane];
+            row_parts[lane] = vertex >= 0 ? get_part_id(graph, vertex) : -1;
+        }
+
+        for (int j = 0; j < sell->slice_widths[s]; j++)
+        {
+            for (int lane = 0; lane < SELL_CHUNK; lane++)
+            {
+                if (j < sell->row_degree[s * SELL_CHUNK + lane] &&
+                    get_part_id(graph, columns[j * SELL_CHUNK + lane]) == row_parts[lane])
+                    counts[lane]++;
+            }
+        }
+
+        for (int lane = 0; lane < SELL_CHUNK; lane++)
+        {
+            int vertex = sell->row_vertex[s * SELL_CHUNK + lane];
+            if (vertex >= 0)
+                internal[vertex] = counts[lane];
+        }
+    }
+}
+#endif
+
+// wierzcholki graniczne maja mniej sasiadow w swojej czesci niz stopien
+void sell_identify_boundary(const Graph *graph, const Sell_graph *sell, bool *is_boundary)
+{
+    int *internal = malloc((graph->vertices > 0 ? graph->vertices : 1) * sizeof(int));
+    if (!internal)
+    {
+        perror("Blad alokacji pamieci dla stopni wewnetrznych");
+        exit(EXIT_FAILURE);
+    }
+
+    sell_internal_degrees(graph, sell, internal);
+    for (int i = 0; i < graph->vertices; i++)
+    {
+        is_boundary[i] = internal[i] < graph->nodes[i].neighbor_count;
+    }
+    free(internal);
+}
+
+// kazda przecieta krawedz jest liczona z obu koncow
+int sell_count_cut_edges(const Graph *graph, const Sell_graph *sell)
+{
+    int *internal = malloc((graph->vertices > 0 ? graph->vertices : 1) * sizeof(int));
+    if (!internal)
+    {
+        perror("Blad alokacji pamieci dla stopni wewnetrznych");
+        exit(EXIT_FAILURE);
+    }
+
+    sell_internal_degrees(graph, sell, internal);
+    long external = 0;
+    for (int i = 0; i < graph->vertices; i++)
+    {
+        external += graph->nodes[i].neighbor_count - internal[i];
+    }
+    free(internal);
+    return (int)(external / 2);
+}
@@ -0,0 +1,551 @@
+#include "spectral.h"
+#include "region_growing.h"
+#include "random.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// buduje laplasjan podgrafu indukowanego
+void build_laplacian(const Graph *graph, const int *vertices, int count, int *local, Laplacian *laplacian)
+{
+    for (int i = 0; i < count; i++)
+    {
+        local[vertices[i]] = i;
+    }
+
+    laplacian->rows = count;
+    laplacian->offsets = malloc((count + 1) * sizeof(int));
+    laplacian->degree = malloc((count > 0 ? count : 1) * sizeof(double));
+    if (!laplacian->offsets || !laplacian->degree)
+    {
+        perror("Blad alokacji pamieci dla laplasjanu");
+        exit(EXIT_FAILURE);
+    }
+
+    // najpierw dlugosci wierszy, potem kolumny
+    laplacian->offsets[0] = 0;
+    for (int i = 0; i < count; i++)
+    {
+        const Node *node = &graph->nodes[vertices[i]];
+        int inside = 0;
+        for (int j = 0; j < node->neighbor_count; j++)
+        {
+            if (local[node->neighbors[j]] >= 0)
+                inside++;
+        }
+        laplacian->offsets[i + 1] = laplacian->offsets[i] + inside;
+        laplacian->degree[i] = inside;
+    }
+
+    int entries = laplacian->offsets[count];
+    laplacian->columns = malloc((entries > 0 ? entries : 1) * sizeof(int));
+    if (!laplacian->columns)
+    {
+        perror("Blad alokacji pamieci dla laplasjanu");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        const Node *node = &graph->nodes[vertices[i]];
+        int position = laplacian->offsets[i];
+        for (int j = 0; j < node->neighbor_count; j++)
+        {
+            int column = local[node->neighbors[j]];
+            if (column >= 0)
+                laplacian->columns[position++] = column;
+        }
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        local[vertices[i]] = -1;
+    }
+}
+
+// zwalnia laplasjan
+void free_laplacian(Laplacian *laplacian)
+{
+    free(laplacian->offsets);
+    free(laplacian->columns);
+    free(laplacian->degree);
+    laplacian->offsets = NULL;
+    laplacian->columns = NULL;
+    laplacian->degree = NULL;
+    laplacian->rows = 0;
+}
+
+// suma x po sasiadach wiersza
+static inline double neighbor_sum(const int *columns, int count, const double *x)
+{
+    int j = 0;
+    double sum = 0.0;
+#if defined(__AVX512F__)
+    __m512d acc = _mm512_setzero_pd();
+    for (; j + 8 <= count; j += 8)
+    {
+        __m256i index = _mm256_loadu_si256((const __m256i *)(columns + j));
+        acc = _mm512_add_pd(acc, _mm512_i32gather_pd(index, x, 8));
+    }
+    sum = _mm512_reduce_add_pd(acc);
+#elif defined(__AVX2__)
+    __m256d acc = _mm256_setzero_pd();
+    for (; j + 4 <= count; j += 4)
+    {
+        __m128i index = _mm_loadu_si128((const __m128i *)(columns + j));
+        acc = _mm256_add_pd(acc, _mm256_i32gather_pd(x, index, 8));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; j < count; j++)
+    {
+        sum += x[columns[j]];
+    }
+    return sum;
+}
+
+// dane wspolne dla zadan mnozenia
+typedef struct
+{
+    const Laplacian *laplacian;
+    const double *x;
+    double *y;
+} Spmv_job;
+
+// zadanie puli - jeden blok wierszy
+static void multiply_block_task(void *arg, int block)
+{
+    Spmv_job *job = arg;
+    const Laplacian *laplacian = job->laplacian;
+    int begin = block * SPMV_BLOCK_ROWS;
+    int end = begin + SPMV_BLOCK_ROWS < laplacian->rows ? begin + SPMV_BLOCK_ROWS : laplacian->rows;
+    for (int i = begin; i < end; i++)
+    {
+        int start = laplacian->offsets[i];
+        job->y[i] = laplacian->degree[i] * job->x[i] -
+                    neighbor_sum(laplacian->columns + start, laplacian->offsets[i + 1] - start, job->x);
+    }
+}
+
+// y = L x
+void laplacian_multiply(const Laplacian *laplacian, const double *x, double *y)
+{
+    Spmv_job job = {laplacian, x, y};
+    int blocks = (laplacian->rows + SPMV_BLOCK_ROWS - 1) / SPMV_BLOCK_ROWS;
+    Thread_pool *pool = laplacian->rows >= PARALLEL_BFS_MIN_VERTICES ? get_thread_pool() : NULL;
+    parallel_for(pool, blocks, multiply_block_task, &job);
+}
+
+// iloczyn skalarny
+static double dot(const double *a, const double *b, int n)
+{
+    double sum = 0.0;
+    for (int i = 0; i < n; i++)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+// usuwa z wektora skladowa stala (wektor wlasny wartosci 0)
+static void remove_mean(double *x, int n)
+{
+    double mean = 0.0;
+    for (int i = 0; i < n; i++)
+        mean += x[i];
+    mean /= n;
+    for (int i = 0; i < n; i++)
+        x[i] -= mean;
+}
+
+// normalizuje wektor, zwraca jego poprzednia dlugosc
+static double normalize(double *x, int n)
+{
+    double norm = sqrt(dot(x, x, n));
+    if (norm > 0.0)
+    {
+        for (int i = 0; i < n; i++)
+            x[i] /= norm;
+    }
+    return norm;
+}
+
+// wartosci i wektory wlasne macierzy trojdiagonalnej metoda QL z niejawnym przesunieciem
+// d - przekatna (na wyjsciu wartosci wlasne), e[i] - element miedzy i oraz i + 1 (niszczony),
+// z - macierz m x m, na wejsciu jednostkowa, na wyjsciu kolumna k to wektor wartosci d[k]
+static void tridiagonal_eigen(double *d, double *e, int m, double *z)
+{
+    for (int l = 0; l < m; l++)
+    {
+        int iterations = 0;
+        int k;
+        do
+        {
+            for (k = l; k < m - 1; k++)
+            {
+                double dd = fabs(d[k]) + fabs(d[k + 1]);
+                if (fabs(e[k]) <= DBL_EPSILON * dd)
+                    break;
+            }
+            if (k == l)
+                break;
+            if (iterations++ == 60)
+                break;
+
+            double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+            double r = hypot(g, 1.0);
+            g = d[k] - d[l] + e[l] / (g + copysign(r, g));
+            double s = 1.0, c = 1.0, p = 0.0;
+            int i;
+            for (i = k - 1; i >= l; i--)
+            {
+                double f = s * e[i];
+                double b = c * e[i];
+                r = hypot(f, g);
+                e[i + 1] = r;
+                if (r == 0.0)
+                {
+                    d[i + 1] -= p;
+                    e[k] = 0.0;
+                    break;
+                }
+                s = f / r;
+                c = g / r;
+                g = d[i + 1] - p;
+                r = (d[i] - g) * s + 2.0 * c * b;
+                p = s * r;
+                d[i + 1] = g + p;
+                g = c * r - b;
+                for (int row = 0; row < m; row++)
+                {
+                    f = z[row * m + i + 1];
+                    z[row * m + i + 1] = s * z[row * m + i] + c * f;
+                    z[row * m + i] = c * z[row * m + i] - s * f;
+                }
+            }
+            if (r == 0.0 && i >= l)
+                continue;
+            d[l] -= p;
+            e[l] = g;
+            e[k] = 0.0;
+        } while (k != l);
+    }
+}
+
+// najmniejsza para Ritza macierzy trojdiagonalnej (alpha, beta) rozmiaru size
+// zwraca numer kolumny z z jej wektorem, residual to ||L y - theta y|| = beta * ostatnia wspolrzedna
+static int smallest_ritz_pair(const double *alpha, const double *beta, int size, double *d, double *e, double *z,
+                              double *residual)
+{
+    for (int i = 0; i < size; i++)
+    {
+        d[i] = alpha[i];
+        e[i] = i + 1 < size ? beta[i] : 0.0;
+        for (int k = 0; k < size; k++)
+            z[i * size + k] = i == k ? 1.0 : 0.0;
+    }
+    tridiagonal_eigen(d, e, size, z);
+
+    int smallest = 0;
+    for (int i = 1; i < size; i++)
+    {
+        if (d[i] < d[smallest])
+            smallest = i;
+    }
+    *residual = fabs(beta[size - 1] * z[(size - 1) * size + smallest]);
+    return smallest;
+}
+
+// odleglosci BFS od wierzcholka pseudo-peryferyjnego (dwa przejscia), znormalizowane do [0, 1]
+// wierzcholki poza skladowa startu dostaja 0.5
+static void level_vector(const Laplacian *laplacian, double *levels)
+{
+    int n = laplacian->rows;
+    int *distance = malloc(n * sizeof(int));
+    int *queue = malloc(n * sizeof(int));
+    if (!distance || !queue)
+    {
+        perror("Blad alokacji pamieci dla metody Lanczosa");
+        exit(EXIT_FAILURE);
+    }
+
+    int start = 0;
+    int farthest = 0;
+    for (int sweep = 0; sweep < 2; sweep++)
+    {
+        for (int i = 0; i < n; i++)
+            distance[i] = -1;
+        int front = 0;
+        int rear = 0;
+        distance[start] = 0;
+        queue[rear++] = start;
+        while (front < rear)
+        {
+            int vertex = queue[front++];
+            farthest = vertex;
+            for (int j = laplacian->offsets[vertex]; j < laplacian->offsets[vertex + 1]; j++)
+            {
+                int neighbor = laplacian->columns[j];
+                if (distance[neighbor] == -1)
+                {
+                    distance[neighbor] = distance[vertex] + 1;
+                    queue[rear++] = neighbor;
+                }
+            }
+        }
+        start = farthest;
+    }
+
+    double depth = distance[farthest] > 0 ? distance[farthest] : 1;
+    for (int i = 0; i < n; i++)
+        levels[i] = distance[i] >= 0 ? distance[i] / depth : 0.5;
+
+    free(distance);
+    free(queue);
+}
+
+// wektor Fiedlera metoda Lanczosa
+void fiedler_vector(const Laplacian *laplacian, double *fiedler)
+{
+    int n = laplacian->rows;
+    if (n <= 2)
+    {
+        for (int i = 0; i < n; i++)
+            fiedler[i] = i;
+        return;
+    }
+
+    // baza musi sie zmiescic w pamieci takze dla bardzo duzych grafow
+    int steps = SPECTRAL_LANCZOS_STEPS < n - 1 ? SPECTRAL_LANCZOS_STEPS : n - 1;
+    long long budget = (1LL << 25) / n;
+    if (steps > budget)
+        steps = budget > 8 ? (int)budget : 8;
+
+    double *basis = malloc((size_t)steps * n * sizeof(double));
+    double *w = malloc(n * sizeof(double));
+    double *alpha = malloc(steps * sizeof(double));
+    double *beta = malloc(steps * sizeof(double));
+    double *d = malloc(steps * sizeof(double));
+    double *e = malloc(steps * sizeof(double));
+    double *z = malloc((size_t)steps * steps * sizeof(double));
+    if (!basis || !w || !alpha || !beta || !d || !e || !z)
+    {
+        perror("Blad alokacji pamieci dla metody Lanczosa");
+        exit(EXIT_FAILURE);
+    }
+
+    // gorne ograniczenie widma z twierdzenia Gerszgorina, skala dla dokladnosci
+    double spectrum = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        if (2.0 * laplacian->degree[i] > spectrum)
+            spectrum = 2.0 * laplacian->degree[i];
+    }
+
+    // wektor startowy to poziomy BFS od wierzcholka pseudo-peryferyjnego - na siatkach jest juz
+    // bliski wektorowi Fiedlera, mala losowa domieszka dodaje pozostale kierunki
+    level_vector(laplacian, fiedler);
+    for (int i = 0; i < n; i++)
+        fiedler[i] += 1e-3 * (random_unit() - 0.5);
+    remove_mean(fiedler, n);
+    if (normalize(fiedler, n) == 0.0)
+    {
+        for (int i = 0; i < n; i++)
+            fiedler[i] = (i & 1) ? 1.0 : -1.0;
+        remove_mean(fiedler, n);
+        normalize(fiedler, n);
+    }
+
+    double tolerance = SPECTRAL_TOLERANCE * spectrum;
+    for (int cycle = 0; cycle < SPECTRAL_RESTARTS; cycle++)
+    {
+        memcpy(basis, fiedler, n * sizeof(double));
+        int size = steps;
+        int smallest = 0;
+        int converged = 0;
+        for (int j = 0; j < steps; j++)
+        {
+            double *q = basis + (size_t)j * n;
+            laplacian_multiply(laplacian, q, w);
+            alpha[j] = dot(w, q, n);
+
+            // pelna reortogonalizacja Grama-Schmidta zastepuje trojczlonowa rekurencje, drugi przebieg
+            // tylko gdy pierwszy mocno skrocil wektor (kryterium Kahana-Parletta "twice is enough")
+            remove_mean(w, n);
+            double before = sqrt(dot(w, w, n));
+            for (int pass = 0; pass < 2; pass++)
+            {
+                for (int i = 0; i <= j; i++)
+                {
+                    const double *qi = basis + (size_t)i * n;
+                    double projection = dot(w, qi, n);
+                    for (int v = 0; v < n; v++)
+                        w[v] -= projection * qi[v];
+                }
+                beta[j] = sqrt(dot(w, w, n));
+                if (beta[j] > 0.7 * before)
+                    break;
+                before = beta[j];
+            }
+
+            // podprzestrzen niezmiennicza - wartosci Ritza sa dokladne
+            int invariant = beta[j] <= 1e-10 * (spectrum > 0.0 ? spectrum : 1.0);
+
+            // co kilka krokow sprawdzamy reszte najmniejszej pary Ritza, zeby nie budowac pelnej bazy
+            if (invariant || j + 1 == steps || (j + 1) % SPECTRAL_CHECK_STEPS == 0)
+            {
+                size = j + 1;
+                double residual;
+                smallest = smallest_ritz_pair(alpha, beta, size, d, e, z, &residual);
+                converged = invariant || residual <= tolerance;
+                if (converged || j + 1 == steps)
+                    break;
+            }
+
+            double *next = basis + (size_t)(j + 1) * n;
+            for (int v = 0; v < n; v++)
+                next[v] = w[v] / beta[j];
+        }
+
+        // wektor Ritza jest punktem startowym kolejnego cyklu
+        memset(fiedler, 0, n * sizeof(double));
+        for (int i = 0; i < size; i++)
+        {
+            double weight = z[i * size + smallest];
+            const double *qi = basis + (size_t)i * n;
+            for (int v = 0; v < n; v++)
+                fiedler[v] += weight * qi[v];
+        }
+        remove_mean(fiedler, n);
+        normalize(fiedler, n);
+
+        if (converged)
+            break;
+    }
+
+    free(basis);
+    free(w);
+    free(alpha);
+    free(beta);
+    free(d);
+    free(e);
+    free(z);
+}
+
+// wierzcholek z wartoscia wektora Fiedlera
+typedef struct
+{
+    double value;
+    int vertex;
+} Spectral_point;
+
+// porownanie po wartosci, remis rozstrzyga numer wierzcholka
+static int compare_spectral_points(const void *a, const void *b)
+{
+    const Spectral_point *pa = a;
+    const Spectral_point *pb = b;
+    if (pa->value != pb->value)
+        return pa->value < pb->value ? -1 : 1;
+    return pa->vertex - pb->vertex;
+}
+
+// dzieli vertices[0..count) na czesci first_part .. first_part + parts - 1
+static void spectral_bisect(Graph *graph, int *vertices, int count, int first_part, int parts, int *local)
+{
+    if (parts == 1)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            set_part_id(graph, vertices[i], first_part);
+        }
+        return;
+    }
+
+    // numeracja lokalna idzie rosnaco po numerach globalnych, co zachowuje lokalnosc pliku
+    Laplacian laplacian;
+    build_laplacian(graph, vertices, count, local, &laplacian);
+    double *fiedler = malloc(count * sizeof(double));
+    Spectral_point *points = malloc(count * sizeof(Spectral_point));
+    if (!fiedler || !points)
+    {
+        perror("Blad alokacji pamieci dla bisekcji spektralnej");
+        exit(EXIT_FAILURE);
+    }
+    fiedler_vector(&laplacian, fiedler);
+    free_laplacian(&laplacian);
+
+    // rozmiar lewej strony proporcjonalny do liczby jej czesci
+    for (int i = 0; i < count; i++)
+    {
+        points[i].value = fiedler[i];
+        points[i].vertex = vertices[i];
+    }
+    qsort(points, count, sizeof(Spectral_point), compare_spectral_points);
+    int left_parts = parts / 2;
+    int split = (int)((long long)count * left_parts / parts);
+
+    // obie polowki znow rosnaco po numerach - stabilny rozdzial tablicy, ktora juz jest posortowana
+    for (int i = 0; i < count; i++)
+    {
+        local[points[i].vertex] = i < split;
+    }
+    int *ordered = (int *)points;
+    int left = 0;
+    int right = split;
+    for (int i = 0; i < count; i++)
+    {
+        if (local[vertices[i]])
+            ordered[left++] = vertices[i];
+        else
+            ordered[right++] = vertices[i];
+        local[vertices[i]] = -1;
+    }
+    memcpy(vertices, ordered, count * sizeof(int));
+    free(fiedler);
+    free(points);
+
+    spectral_bisect(graph, vertices, split, first_part, left_parts, local);
+    spectral_bisect(graph, vertices + split, count - split, first_part + left_parts, parts - left_parts, local);
+}
+
+// podzial wstepny przez rekurencyjna bisekcje spektralna
+int spectral_partition(Graph *graph, int parts, Partition_data *partition_data, float accuracy)
+{
+    if (parts > graph->vertices)
+    {
+        perror("Liczba czesci nie moze byc wieksza od liczby wierzcholkow");
+        exit(EXIT_FAILURE);
+    }
+
+    assing_parts(graph, parts);
+    int n = graph->vertices;
+    int *vertices = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *local = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *part_counts = calloc(parts, sizeof(int));
+    if (!vertices || !local || !part_counts)
+    {
+        perror("Blad alokacji pamieci dla bisekcji spektralnej");
+        exit(EXIT_FAILURE);
+    }
+    for (int v = 0; v < n; v++)
+    {
+        vertices[v] = v;
+        local[v] = -1;
+    }
+
+    spectral_bisect(graph, vertices, n, 0, parts, local);
+    free(vertices);
+    free(local);
+
+    // przypiete wierzcholki ida do swoich czesci niezaleznie od wektora Fiedlera
+    for (int v = 0; v < n; v++)
+    {
+        if (is_pinned(graph, v))
+            set_part_id(graph, v, graph->pinned[v]);
+        part_counts[get_part_id(graph, v)]++;
+    }
+
+    int success = complete_partition(graph, parts, partition_data, part_counts, accuracy);
+    free(part_counts);
+    return success;
+}
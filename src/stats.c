@@ -1,4 +1,7 @@
 #include "stats.h"
+#include "msbfs.h"
+#include "quotient_graph.h"
+#include "sell_graph.h"
 #include <math.h>
 
 // oblicza odchylenie standardowe
@@ -80,16 +83,43 @@ void print_statistics(const Graph *graph, const Partition_data *partition_data,
     int max_part_cuts = 0;
     int min_part_cuts = total_edges;
     
-    for (int i = 0; i < graph->vertices; i++) {
-        int part1 = graph->nodes[i].part_id;
-        for (int j = 0; j < graph->nodes[i].neighbor_count; j++) {
-            int neighbor = graph->nodes[i].neighbors[j];
-            int part2 = graph->nodes[neighbor].part_id;
-            if (part1 != part2) {
-                cut_edges++;
-                partition_cuts[part1]++;
-            }
+    // graf ilorazowy jest aktualny po kazdym ruchu, wiec przeciecia czytamy z niego
+    const Quotient_graph *quotient = graph->quotient && graph->quotient->parts == parts ? graph->quotient : NULL;
+    for (int p = 0; quotient && p < parts; p++) {
+        partition_cuts[p] = quotient_part_cut(quotient, p);
+        cut_edges += partition_cuts[p];
+    }
+
+    // bez grafu ilorazowego, z ukladem SELL przeciecia wierzcholka to stopien minus stopien wewnetrzny
+    if (!quotient && graph->sell) {
+        int *internal = malloc(graph->vertices * sizeof(int));
+        if (!internal) {
+            perror("Blad alokacji pamieci dla stopni wewnetrznych");
+            exit(EXIT_FAILURE);
+        }
+        sell_internal_degrees(graph, graph->sell, internal);
+        for (int i = 0; i < graph->vertices; i++) {
+            int external = graph->nodes[i].neighbor_count - internal[i];
+            cut_edges += external;
+            partition_cuts[get_part_id(graph, i)] += external;
+        }
+        free(internal);
+    }
+
+    // w pozostalych przypadkach przeciecia czesci to suma stopni jej wierzcholkow minus sasiedzi wewnatrz czesci
+    for (int p = 0; !quotient && !graph->sell && p < parts; p++) {
+        Part_neighbors part_neighbors;
+        if (!get_part_neighbors(graph, partition_data, p, &part_neighbors)) {
+            perror("Blad przy pobieraniu sasiadow z czesci");
+            exit(EXIT_FAILURE);
+        }
+        int degree_sum = 0;
+        for (int i = 0; i < part_neighbors.size; i++) {
+            degree_sum += graph->nodes[part_neighbors.vertices[i]].neighbor_count;
         }
+        partition_cuts[p] = degree_sum - part_neighbors.offsets[part_neighbors.size];
+        cut_edges += partition_cuts[p];
+        free_part_neighbors(&part_neighbors);
     }
     cut_edges /= 2;
 
@@ -112,6 +142,9 @@ void print_statistics(const Graph *graph, const Partition_data *partition_data,
         printf("  - Procent wszystkich przeciec: %.2f%%\n", 
                (float)partition_cuts[i]/cut_edges*100);
     }
+    if (quotient) {
+        print_quotient_graph(quotient);
+    }
 
     // 4. Wydajnosc
     printf("\n=== Metryki wydajnosci ===\n");
@@ -139,7 +172,7 @@ void print_precompute_metrics(const Graph *graph, const Partition_data *partitio
     total_edges /= 2;
     
     // Statystyki pamieci
-    double memory_per_vertex = sizeof(Node);
+    double memory_per_vertex = sizeof(Node) + graph->part_id_width; // wezel i wpis w tablicy przypisan
     double memory_per_edge = sizeof(int) * 2; // każda krawędź jest przechowywana 2 razy
     double memory_per_partition = sizeof(Part); // pamięć na strukturę partycji
     double total_partition_memory = (memory_per_partition * parts + 
@@ -160,13 +193,25 @@ void print_precompute_metrics(const Graph *graph, const Partition_data *partitio
     printf("- Sredni stopien wierzcholka: %.2f\n", avg_degree);
     printf("- Gestosc grafu: %.4f%%\n", 
            (float)(total_edges * 2) / (graph->vertices * (graph->vertices - 1)) * 100);
+
+    // srednica szacowana z jednego przebiegu wielozrodlowego BFS z rownomiernie rozlozonych wierzcholkow
+    int sample_count = graph->vertices < MSBFS_MAX_SOURCES ? graph->vertices : MSBFS_MAX_SOURCES;
+    int *samples = malloc(sample_count * sizeof(int));
+    if (samples) {
+        for (int i = 0; i < sample_count; i++) {
+            samples[i] = (int)((long)i * graph->vertices / sample_count);
+        }
+        Msbfs_state *state = create_msbfs_state(graph->vertices);
+        printf("- Szacowana srednica: %d\n", estimate_pseudo_diameter(graph, state, samples, sample_count, NULL));
+        free_msbfs_state(state);
+        free(samples);
+    }
     
     // Analiza partycji i alokacji
     int total_partition_vertices = 0;
-    int total_partition_capacity = 0;
+    int total_partition_capacity = partition_data->vertex_capacity;
     for (int i = 0; i < parts; i++) {
         total_partition_vertices += partition_data->parts[i].part_vertex_count;
-        total_partition_capacity += partition_data->parts[i].capacity;
     }
     
     printf("\nAnaliza struktur partycji:\n");
@@ -176,7 +221,7 @@ void print_precompute_metrics(const Graph *graph, const Partition_data *partitio
            (double)graph->vertices / parts);
     printf("- Calkowita zarezerwowana pojemnosc: %d\n", total_partition_capacity);
     printf("- Wykorzystanie pamieci partycji: %.2f%%\n", 
-           (float)total_partition_vertices / total_partition_capacity * 100);
+           total_partition_capacity > 0 ? (float)total_partition_vertices / total_partition_capacity * 100 : 0.0f);
     
     // Statystyki operacji
     printf("\nOperacje przed podziałem:\n");
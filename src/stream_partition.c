@@ -0,0 +1,336 @@
+#include "stream_partition.h"
+#include "part_heap.h"
+
+// buforowany odczyt liczb z pliku csrrg, bez wczytywania calych linii
+typedef struct
+{
+    FILE *file;
+    size_t position;
+    size_t length;
+    char buffer[STREAM_BUFFER_SIZE];
+} Stream_reader;
+
+// nastepny znak pliku albo EOF
+static inline int reader_next(Stream_reader *reader)
+{
+    if (reader->position == reader->length)
+    {
+        reader->length = fread(reader->buffer, 1, STREAM_BUFFER_SIZE, reader->file);
+        reader->position = 0;
+        if (reader->length == 0)
+            return EOF;
+    }
+    return (unsigned char)reader->buffer[reader->position++];
+}
+
+// czyta nastepna liczbe biezacej linii
+// zwraca 1 gdy liczba zostala wczytana, 0 na koncu linii (znak nowej linii jest zjadany) lub pliku
+static int read_value(Stream_reader *reader, int *value)
+{
+    int c = reader_next(reader);
+    while (c == ';' || c == ' ' || c == '\t' || c == '\r')
+        c = reader_next(reader);
+    if (c == '\n' || c == EOF)
+        return 0;
+
+    int sign = 1;
+    if (c == '-')
+    {
+        sign = -1;
+        c = reader_next(reader);
+    }
+    long number = 0;
+    while (c >= '0' && c <= '9')
+    {
+        number = number * 10 + (c - '0');
+        c = reader_next(reader);
+    }
+
+    // koniec linii zostawiamy dla nastepnego wywolania
+    if (c == '\n')
+        reader->position--;
+    *value = (int)(sign * number);
+    return 1;
+}
+
+// pomija reszte linii, zwraca liczbe pominietych liczb
+static long skip_line(Stream_reader *reader)
+{
+    long count = 0;
+    int value;
+    while (read_value(reader, &value))
+        count++;
+    return count;
+}
+
+// stan podzialu strumieniowego
+typedef struct
+{
+    Graph *graph;
+    Stream_scoring scoring;
+    int capacity;      // najwiekszy rozmiar czesci
+    double alpha;      // waga kary za rozmiar w ocenie Fennel
+    int *vote_parts;   // glosy wierzcholkow: czesci (-1 = wolne miejsce), STREAM_VOTE_SLOTS na wierzcholek
+    int *vote_counts;  // glosy wierzcholkow: liczniki
+    int *counts;       // liczba przypisanych sasiadow w kazdej czesci
+    int *touched;      // czesci z niezerowym licznikiem
+    int touched_count;
+    Part_heap *smallest; // czesci wedlug rozmiaru - najlepsza czesc bez sasiadow to najmniejsza
+} Stream_state;
+
+// ocena czesci dla wierzcholka z neighbors sasiadami w tej czesci
+static double score_part(const Stream_state *state, int part, int neighbors)
+{
+    int size = state->graph->part_sizes[part];
+    if (state->scoring == STREAM_LDG)
+        return neighbors * (1.0 - (double)size / state->capacity);
+    return neighbors - state->alpha * FENNEL_GAMMA * pow(size, FENNEL_GAMMA - 1.0);
+}
+
+// dolicza weight sasiadow w czesci
+static inline void count_neighbor(Stream_state *state, int part, int weight)
+{
+    if (state->counts[part] == 0)
+        state->touched[state->touched_count++] = part;
+    state->counts[part] += weight;
+}
+
+// zostawia wierzcholkowi glos na czesc przypisanego sasiada
+// przy pelnych miejscach wszystkie liczniki maleja (Misra-Gries), wiec zostaja najczestsze czesci
+static void add_vote(Stream_state *state, int vertex, int part)
+{
+    int *parts = &state->vote_parts[(size_t)vertex * STREAM_VOTE_SLOTS];
+    int *counts = &state->vote_counts[(size_t)vertex * STREAM_VOTE_SLOTS];
+    int empty = -1;
+    for (int s = 0; s < STREAM_VOTE_SLOTS; s++)
+    {
+        if (parts[s] == part)
+        {
+            counts[s]++;
+            return;
+        }
+        if (parts[s] == -1 && empty == -1)
+            empty = s;
+    }
+    if (empty != -1)
+    {
+        parts[empty] = part;
+        counts[empty] = 1;
+        return;
+    }
+    for (int s = 0; s < STREAM_VOTE_SLOTS; s++)
+    {
+        if (--counts[s] == 0)
+            parts[s] = -1;
+    }
+}
+
+// dolicza glosy wierzcholka do licznikow czesci
+static void count_votes(Stream_state *state, int vertex)
+{
+    const int *parts = &state->vote_parts[(size_t)vertex * STREAM_VOTE_SLOTS];
+    const int *counts = &state->vote_counts[(size_t)vertex * STREAM_VOTE_SLOTS];
+    for (int s = 0; s < STREAM_VOTE_SLOTS; s++)
+    {
+        if (parts[s] >= 0)
+            count_neighbor(state, parts[s], counts[s]);
+    }
+}
+
+// zeruje liczniki czesci
+static void clear_counts(Stream_state *state)
+{
+    for (int i = 0; i < state->touched_count; i++)
+    {
+        state->counts[state->touched[i]] = 0;
+    }
+    state->touched_count = 0;
+}
+
+// przypisuje wierzcholek do czesci o najlepszej ocenie i zeruje liczniki
+// kandydaci to czesci sasiadow i najmniejsza czesc, pozostale czesci bez sasiadow oceniaja sie gorzej od niej
+static void assign_streamed(Stream_state *state, int vertex)
+{
+    int best = part_heap_top(state->smallest);
+    double best_score = score_part(state, best, state->counts[best]);
+    for (int i = 0; i < state->touched_count; i++)
+    {
+        int part = state->touched[i];
+        if (state->graph->part_sizes[part] >= state->capacity)
+            continue;
+        double score = score_part(state, part, state->counts[part]);
+        if (score > best_score ||
+            (score == best_score && state->graph->part_sizes[part] < state->graph->part_sizes[best]))
+        {
+            best = part;
+            best_score = score;
+        }
+    }
+
+    set_part_id(state->graph, vertex, best);
+    part_heap_update(state->smallest, best);
+    clear_counts(state);
+}
+
+// podzial strumieniowy pliku csrrg
+int stream_partition(const char *filename, int parts, float accuracy, Stream_scoring scoring, Graph *graph)
+{
+    Stream_reader *reader = malloc(sizeof(Stream_reader));
+    if (!reader)
+    {
+        perror("Blad alokacji pamieci dla odczytu strumieniowego");
+        exit(EXIT_FAILURE);
+    }
+    reader->file = fopen(filename, "rb");
+    if (!reader->file)
+    {
+        perror("nie mozna otworzyc pliku");
+        free(reader);
+        return 0;
+    }
+    reader->position = 0;
+    reader->length = 0;
+
+    // linia 1 (szerokosc) i 3 (wskazniki wierszy) nie sa potrzebne, linia 2 daje liczbe wierzcholkow
+    skip_line(reader);
+    long vertices = skip_line(reader);
+    skip_line(reader);
+
+    // pozycja czwartej linii - wskazniki grup sa dopiero w piatej, wiec krawedzie tylko przeskakujemy
+    long edges_offset = ftell(reader->file) - (long)(reader->length - reader->position);
+    long entries = skip_line(reader);
+
+    int *group_start = malloc((vertices + 1) * sizeof(int));
+    if (!group_start)
+    {
+        perror("Blad alokacji pamieci dla odczytu strumieniowego");
+        exit(EXIT_FAILURE);
+    }
+    int groups = 0;
+    int value;
+    while (read_value(reader, &value))
+    {
+        if (groups < vertices)
+            group_start[groups++] = value;
+    }
+    group_start[groups] = (int)entries;
+
+    // graf bez list sasiadow - tylko tablica przypisan i rozmiary czesci
+    memset(graph, 0, sizeof(Graph));
+    graph->vertices = (int)vertices;
+    assing_parts(graph, parts);
+
+    Stream_state state;
+    state.graph = graph;
+    state.scoring = scoring;
+    float avg_vertices_per_part = (float)vertices / parts;
+    state.capacity = (int)(avg_vertices_per_part * (1.0 + accuracy));
+    if ((long)state.capacity * parts < vertices)
+        state.capacity = (int)((vertices + parts - 1) / parts);
+    // alfa z pracy o Fennel: sqrt(k) * m / n^gamma
+    state.alpha = vertices > 0 ? sqrt(parts) * entries / pow(vertices, FENNEL_GAMMA) : 0.0;
+    state.vote_parts = malloc((vertices > 0 ? vertices : 1) * STREAM_VOTE_SLOTS * sizeof(int));
+    state.vote_counts = calloc((vertices > 0 ? vertices : 1) * STREAM_VOTE_SLOTS, sizeof(int));
+    state.counts = calloc(parts, sizeof(int));
+    state.touched = malloc(parts * sizeof(int));
+    state.touched_count = 0;
+    state.smallest = create_part_heap(parts, graph->part_sizes);
+    int member_capacity = 64;
+    int *members = malloc(member_capacity * sizeof(int));
+    if (!state.vote_parts || !state.vote_counts || !state.counts || !state.touched || !members)
+    {
+        perror("Blad alokacji pamieci dla odczytu strumieniowego");
+        exit(EXIT_FAILURE);
+    }
+    for (int p = 0; p < parts; p++)
+    {
+        part_heap_push(state.smallest, p);
+    }
+    for (long i = 0; i < vertices * STREAM_VOTE_SLOTS; i++)
+    {
+        state.vote_parts[i] = -1;
+    }
+
+    // jedno przejscie po krawedziach: grupa g to sasiedzi wierzcholka g
+    fseek(reader->file, edges_offset, SEEK_SET);
+    reader->position = 0;
+    reader->length = 0;
+    for (int g = 0; g < groups; g++)
+    {
+        int size = group_start[g + 1] - group_start[g];
+        if (size > member_capacity)
+        {
+            while (member_capacity < size)
+                member_capacity *= 2;
+            int *new_members = realloc(members, member_capacity * sizeof(int));
+            if (!new_members)
+            {
+                perror("Blad alokacji pamieci dla odczytu strumieniowego");
+                exit(EXIT_FAILURE);
+            }
+            members = new_members;
+        }
+        int count = 0;
+        while (count < size && read_value(reader, &members[count]))
+        {
+            if (members[count] >= 0 && members[count] < vertices && members[count] != g)
+                count++;
+            else
+                size--;
+        }
+
+        // sasiedzi z listy, ktorzy maja juz czesc, i glosy od wczesniejszych grup z tym wierzcholkiem
+        for (int i = 0; i < count; i++)
+        {
+            int part = get_part_id(graph, members[i]);
+            if (part >= 0)
+                count_neighbor(&state, part, 1);
+        }
+        if (get_part_id(graph, g) == -1)
+        {
+            count_votes(&state, g);
+            assign_streamed(&state, g);
+        }
+        else
+        {
+            clear_counts(&state);
+        }
+
+        // wolni sasiedzi dostaja glos na czesc wierzcholka grupy, a wierzcholek bez wlasnej grupy
+        // nie dostanie lepszej okazji - idzie od razu za sasiadem i swoimi glosami
+        int head_part = get_part_id(graph, g);
+        for (int i = 0; i < count; i++)
+        {
+            if (get_part_id(graph, members[i]) != -1)
+                continue;
+            if (members[i] >= groups)
+            {
+                count_votes(&state, members[i]);
+                count_neighbor(&state, head_part, 1);
+                assign_streamed(&state, members[i]);
+            }
+            else
+            {
+                add_vote(&state, members[i], head_part);
+            }
+        }
+    }
+
+    // wierzcholki nieobecne w zadnej grupie ida do najmniejszych czesci
+    for (int v = 0; v < vertices; v++)
+    {
+        if (get_part_id(graph, v) == -1)
+            assign_streamed(&state, v);
+    }
+
+    free(members);
+    free(state.vote_parts);
+    free(state.vote_counts);
+    free(state.counts);
+    free(state.touched);
+    free_part_heap(state.smallest);
+    free(group_start);
+    fclose(reader->file);
+    free(reader);
+    return 1;
+}
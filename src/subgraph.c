@@ -0,0 +1,105 @@
+#include "subgraph.h"
+
+// dane wspolne dla zadan wydzielania podgrafow
+typedef struct
+{
+    const Graph *graph;
+    const Part_index *index;
+    Subgraph_set *set;
+} Subgraph_job;
+
+// zadanie puli - lokalny CSR jednej czesci
+static void extract_part_task(void *arg, int part)
+{
+    Subgraph_job *job = arg;
+    const Graph *graph = job->graph;
+    const int *local_index = job->index->local_index;
+    const int *members = job->index->members + job->index->offsets[part];
+    int size = job->index->offsets[part + 1] - job->index->offsets[part];
+    Part_subgraph *subgraph = &job->set->subgraphs[part];
+
+    subgraph->part = part;
+    subgraph->vertices = size;
+    subgraph->local_to_global = malloc((size > 0 ? size : 1) * sizeof(int));
+    subgraph->offsets = malloc((size + 1) * sizeof(int));
+    if (!subgraph->local_to_global || !subgraph->offsets)
+    {
+        perror("Blad alokacji pamieci dla podgrafu czesci");
+        exit(EXIT_FAILURE);
+    }
+
+    // pierwsze przejscie liczy krawedzie wewnetrzne, drugie je wypelnia
+    subgraph->offsets[0] = 0;
+    for (int i = 0; i < size; i++)
+    {
+        const Node *node = &graph->nodes[members[i]];
+        int internal = 0;
+        for (int j = 0; j < node->neighbor_count; j++)
+        {
+            if (get_part_id(graph, node->neighbors[j]) == part)
+                internal++;
+        }
+        subgraph->local_to_global[i] = members[i];
+        subgraph->offsets[i + 1] = subgraph->offsets[i] + internal;
+    }
+
+    subgraph->neighbors = malloc((subgraph->offsets[size] > 0 ? subgraph->offsets[size] : 1) * sizeof(int));
+    if (!subgraph->neighbors)
+    {
+        perror("Blad alokacji pamieci dla podgrafu czesci");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < size; i++)
+    {
+        const Node *node = &graph->nodes[members[i]];
+        int position = subgraph->offsets[i];
+        for (int j = 0; j < node->neighbor_count; j++)
+        {
+            int neighbor = node->neighbors[j];
+            if (get_part_id(graph, neighbor) == part)
+                subgraph->neighbors[position++] = local_index[neighbor];
+        }
+    }
+}
+
+// wydziela podgrafy wszystkich czesci
+void extract_subgraphs(const Graph *graph, int parts, Subgraph_set *set)
+{
+    set->parts = parts;
+    set->subgraphs = calloc(parts > 0 ? parts : 1, sizeof(Part_subgraph));
+    if (!set->subgraphs)
+    {
+        perror("Blad alokacji pamieci dla podgrafow");
+        exit(EXIT_FAILURE);
+    }
+
+    // indeks czesci daje od razu obie numeracje - members jest rosnace w kazdej czesci
+    Part_index index;
+    build_part_index(graph, parts, &index);
+
+    Subgraph_job job = {graph, &index, set};
+    Thread_pool *pool = graph->vertices >= PARALLEL_BFS_MIN_VERTICES ? get_thread_pool() : NULL;
+    parallel_for(pool, parts, extract_part_task, &job);
+
+    // numeracje lokalna przejmujemy z indeksu, reszta indeksu nie jest juz potrzebna
+    set->global_to_local = index.local_index;
+    index.local_index = NULL;
+    free_part_index(&index);
+}
+
+// zwalnia podgrafy
+void free_subgraphs(Subgraph_set *set)
+{
+    for (int p = 0; p < set->parts; p++)
+    {
+        free(set->subgraphs[p].local_to_global);
+        free(set->subgraphs[p].offsets);
+        free(set->subgraphs[p].neighbors);
+    }
+    free(set->subgraphs);
+    free(set->global_to_local);
+    set->subgraphs = NULL;
+    set->global_to_local = NULL;
+    set->parts = 0;
+}
@@ -0,0 +1,185 @@
+#include "thread_pool.h"
+#include <unistd.h>
+
+// wspolna pula programu i zadana liczba watkow
+static Thread_pool *shared_pool = NULL;
+static int shared_thread_count = 0;
+static pthread_mutex_t shared_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// czy biezacy watek wykonuje wlasnie zadanie z puli
+static __thread int inside_task = 0;
+
+// pobiera i wykonuje zadania az do wyczerpania licznika
+static void run_tasks(Thread_pool *pool)
+{
+    inside_task = 1;
+    while (1)
+    {
+        int task = __atomic_fetch_add(&pool->next_task, 1, __ATOMIC_RELAXED);
+        if (task >= pool->task_count)
+            break;
+        pool->function(pool->arg, task);
+    }
+    inside_task = 0;
+}
+
+// glowna petla watku roboczego
+static void *worker_main(void *arg)
+{
+    Thread_pool *pool = arg;
+    unsigned int seen_generation = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    while (1)
+    {
+        // czekamy na nowe zlecenie albo zakonczenie
+        while (!pool->shutdown && pool->generation == seen_generation)
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        if (pool->shutdown)
+            break;
+        seen_generation = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        run_tasks(pool);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->active_workers == 0)
+            pthread_cond_signal(&pool->work_done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+// tworzy pule watkow
+Thread_pool *create_thread_pool(int threads)
+{
+    if (threads <= 0)
+    {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cores > 0 ? (int)cores : 1;
+    }
+
+    Thread_pool *pool = calloc(1, sizeof(Thread_pool));
+    if (!pool)
+    {
+        perror("Blad alokacji pamieci dla puli watkow");
+        exit(EXIT_FAILURE);
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_mutex_init(&pool->submit_lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+
+    // watek wywolujacy tez wykonuje zadania, wiec tworzymy o jeden mniej
+    pool->thread_count = threads - 1;
+    pool->threads = malloc((pool->thread_count > 0 ? pool->thread_count : 1) * sizeof(pthread_t));
+    if (!pool->threads)
+    {
+        perror("Blad alokacji pamieci dla watkow");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < pool->thread_count; i++)
+    {
+        if (pthread_create(&pool->threads[i], NULL, worker_main, pool) != 0)
+        {
+            // jesli system nie da wiecej watkow, pracujemy na tych co sa
+            pool->thread_count = i;
+            break;
+        }
+    }
+
+    return pool;
+}
+
+// konczy watki i zwalnia pule
+void destroy_thread_pool(Thread_pool *pool)
+{
+    if (!pool)
+        return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->thread_count; i++)
+        pthread_join(pool->threads[i], NULL);
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->submit_lock);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_cond_destroy(&pool->work_done);
+    free(pool->threads);
+    free(pool);
+}
+
+// wykonuje petle rownolegle
+void parallel_for(Thread_pool *pool, int task_count, Task_function function, void *arg)
+{
+    if (task_count <= 0)
+        return;
+
+    // bez watkow roboczych, przy jednym zadaniu albo z wnetrza zadania liczymy szeregowo
+    if (!pool || pool->thread_count == 0 || task_count == 1 || inside_task)
+    {
+        for (int task = 0; task < task_count; task++)
+            function(arg, task);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->submit_lock);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->function = function;
+    pool->arg = arg;
+    pool->task_count = task_count;
+    pool->next_task = 0;
+    pool->active_workers = pool->thread_count;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    // watek wywolujacy pracuje razem z pula
+    run_tasks(pool);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->active_workers > 0)
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_mutex_unlock(&pool->submit_lock);
+}
+
+// zwraca wspolna pule programu
+Thread_pool *get_thread_pool(void)
+{
+    pthread_mutex_lock(&shared_pool_lock);
+    if (!shared_pool)
+        shared_pool = create_thread_pool(shared_thread_count);
+    Thread_pool *pool = shared_pool;
+    pthread_mutex_unlock(&shared_pool_lock);
+    return pool;
+}
+
+// ustawia liczbe watkow wspolnej puli
+void set_thread_count(int threads)
+{
+    pthread_mutex_lock(&shared_pool_lock);
+    shared_thread_count = threads;
+    if (shared_pool)
+    {
+        destroy_thread_pool(shared_pool);
+        shared_pool = NULL;
+    }
+    pthread_mutex_unlock(&shared_pool_lock);
+}
+
+// zwalnia wspolna pule
+void release_thread_pool(void)
+{
+    pthread_mutex_lock(&shared_pool_lock);
+    destroy_thread_pool(shared_pool);
+    shared_pool = NULL;
+    pthread_mutex_unlock(&shared_pool_lock);
+}
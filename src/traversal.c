@@ -0,0 +1,144 @@
+#include "traversal.h"
+#include <pthread.h>
+
+// klucz do bufora roboczego watku, destruktor zwalnia bufor przy zakonczeniu watku
+static pthread_key_t workspace_key;
+static pthread_once_t workspace_key_once = PTHREAD_ONCE_INIT;
+
+// zwalnia bufory instancji
+static void free_workspace(void *ptr)
+{
+    Traversal_workspace *workspace = ptr;
+    if (!workspace)
+        return;
+    free(workspace->marks);
+    free(workspace->queue);
+    free(workspace->labels);
+    free(workspace->bitmaps);
+    free(workspace);
+}
+
+static void create_workspace_key(void)
+{
+    pthread_key_create(&workspace_key, free_workspace);
+}
+
+// zwraca bufor roboczy biezacego watku, w razie potrzeby go powieksza
+Traversal_workspace *get_traversal_workspace(int vertices)
+{
+    pthread_once(&workspace_key_once, create_workspace_key);
+
+    Traversal_workspace *workspace = pthread_getspecific(workspace_key);
+    if (!workspace)
+    {
+        workspace = calloc(1, sizeof(Traversal_workspace));
+        if (!workspace)
+        {
+            perror("Blad alokacji pamieci dla bufora przejsc");
+            exit(EXIT_FAILURE);
+        }
+        pthread_setspecific(workspace_key, workspace);
+    }
+
+    // powiekszamy bufory tylko dla wiekszego grafu, znaczniki zerujemy jednorazowo
+    if (vertices > workspace->capacity)
+    {
+        free(workspace->marks);
+        free(workspace->queue);
+        free(workspace->labels);
+        workspace->marks = calloc(vertices, sizeof(unsigned int));
+        workspace->queue = malloc(vertices * sizeof(int));
+        workspace->labels = malloc(vertices * sizeof(int));
+        if (!workspace->marks || !workspace->queue || !workspace->labels)
+        {
+            perror("Blad alokacji pamieci dla bufora przejsc");
+            exit(EXIT_FAILURE);
+        }
+        workspace->capacity = vertices;
+        workspace->epoch = 0;
+    }
+
+    return workspace;
+}
+
+// zwalnia bufor roboczy biezacego watku
+void release_traversal_workspace(void)
+{
+    pthread_once(&workspace_key_once, create_workspace_key);
+    free_workspace(pthread_getspecific(workspace_key));
+    pthread_setspecific(workspace_key, NULL);
+}
+
+// zwraca wyzerowany bufor map bitowych, powiekszajac go w razie potrzeby
+uint64_t *get_bitmap_buffer(Traversal_workspace *workspace, size_t words)
+{
+    if (words > workspace->bitmap_words)
+    {
+        free(workspace->bitmaps);
+        workspace->bitmaps = malloc(words * sizeof(uint64_t));
+        if (!workspace->bitmaps)
+        {
+            perror("Blad alokacji pamieci dla map bitowych");
+            exit(EXIT_FAILURE);
+        }
+        workspace->bitmap_words = words;
+    }
+
+    // zerujemy tylko uzywana czesc, koszt jest proporcjonalny do rozmiaru zadania
+    memset(workspace->bitmaps, 0, words * sizeof(uint64_t));
+    return workspace->bitmaps;
+}
+
+// rozpoczyna nowe przejscie
+void begin_traversal(Traversal_workspace *workspace)
+{
+    workspace->epoch++;
+
+    // po przepelnieniu licznika stare znaczniki moglyby sie pokryc z nowa epoka
+    if (workspace->epoch == 0)
+    {
+        memset(workspace->marks, 0, workspace->capacity * sizeof(unsigned int));
+        workspace->epoch = 1;
+    }
+}
+
+// BFS ograniczony do jednej czesci grafu
+int bfs_within_part(const Graph *graph, Traversal_workspace *workspace, int start, int part_id, int skip_vertex)
+{
+    int front = 0, rear = 0;
+    int *queue = workspace->queue;
+
+    if (skip_vertex >= 0)
+        mark_visited(workspace, skip_vertex);
+    mark_visited(workspace, start);
+    queue[rear++] = start;
+
+    while (front < rear)
+    {
+        int current = queue[front++];
+        const Node *node = &graph->nodes[current];
+
+        for (int i = 0; i < node->neighbor_count; i++)
+        {
+            int neighbor = node->neighbors[i];
+            // dodajemy do kolejki tylko sasiadow z tej samej czesci
+            if (get_part_id(graph, neighbor) == part_id && mark_visited(workspace, neighbor))
+            {
+                queue[rear++] = neighbor;
+            }
+        }
+    }
+
+    return rear;
+}
+
+// szuka dowolnego wierzcholka czesci, przerywa przy pierwszym trafieniu
+int find_part_vertex(const Graph *graph, int part_id, int skip_vertex)
+{
+    for (int i = 0; i < graph->vertices; i++)
+    {
+        if (i != skip_vertex && get_part_id(graph, i) == part_id)
+            return i;
+    }
+    return -1;
+}
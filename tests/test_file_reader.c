@@ -3,6 +3,8 @@
 #include "file_reader.h"
 #include "graph.h"
 #include "partition.h"
+#include "part_file.h"
+#include "stream_partition.h"
 
 // pomocnicza funkcja do wyswietlania wyniku testu
 void print_test_result(const char *test_name, int result) {
@@ -54,17 +56,21 @@ void test_add_neighbor() {
 
 // test partycji
 void test_partition() {
+    Graph graph;
     Partition_data partition_data;
+    inicialize_graph(&graph, 6);
+    assing_parts(&graph, 2);
     initialize_partition_data(&partition_data, 2);
     
-    // dodaj wierzcholki do pierwszej partycji
-    add_partition_data(&partition_data, 0, 1);
-    add_partition_data(&partition_data, 0, 2);
-    add_partition_data(&partition_data, 0, 3);
+    // przypisz wierzcholki do pierwszej partycji
+    set_part_id(&graph, 1, 0);
+    set_part_id(&graph, 2, 0);
+    set_part_id(&graph, 3, 0);
     
-    // dodaj wierzcholki do drugiej partycji
-    add_partition_data(&partition_data, 1, 4);
-    add_partition_data(&partition_data, 1, 5);
+    // przypisz wierzcholki do drugiej partycji
+    set_part_id(&graph, 4, 1);
+    set_part_id(&graph, 5, 1);
+    rebuild_partition_data(&partition_data, &graph);
     
     // sprawdz czy wierzcholki sa w odpowiednich partycjach
     assert(partition_data.parts[0].part_vertex_count == 3 && "Zla liczba wierzcholkow w partycji 0");
@@ -72,6 +78,210 @@ void test_partition() {
     
     print_test_result("Test partycji", 1);
     free_partition_data(&partition_data, 2);
+    free_graph(&graph);
+}
+
+// test zapisu i odczytu pliku .part przez mmap
+void test_part_file() {
+    // 5 czesci daje 3 bity na wpis, 300 czesci 9 bitow - w obu przypadkach wpisy przechodza przez granice slow
+    int part_counts[] = {5, 300};
+    for (int t = 0; t < 2; t++) {
+        Graph graph;
+        int parts = part_counts[t];
+        inicialize_graph(&graph, 1000);
+        assing_parts(&graph, parts);
+        for (int v = 0; v < graph.vertices; v++) {
+            set_part_id(&graph, v, (v * 7) % parts);
+        }
+
+        const char *filename = "/tmp/test_part_file.part";
+        assert(write_part_file(filename, &graph) && "Nie udalo sie zapisac pliku .part");
+
+        Part_file file;
+        assert(open_part_file(filename, &file) && "Nie udalo sie otworzyc pliku .part");
+        assert(file.vertices == 1000 && file.parts == (uint32_t)parts && "Nieprawidlowy naglowek");
+        assert(file.bits == part_file_bits(parts) && "Nieprawidlowa liczba bitow");
+        for (int v = 0; v < graph.vertices; v++) {
+            assert(part_file_lookup(&file, v) == get_part_id(&graph, v) && "Nieprawidlowy wpis w pliku .part");
+        }
+
+        close_part_file(&file);
+        remove(filename);
+        free_graph(&graph);
+    }
+
+    // wierzcholek bez czesci nie moze byc zapisany
+    Graph graph;
+    inicialize_graph(&graph, 3);
+    assing_parts(&graph, 2);
+    set_part_id(&graph, 0, 1);
+    assert(!write_part_file("/tmp/test_part_file.part", &graph) && "Zapisano niepelne przypisanie");
+    free_graph(&graph);
+
+    print_test_result("Test pliku .part", 1);
+}
+
+// test wspolrzednych wierzcholkow odczytanych z drugiej i trzeciej linii
+void test_grid_coordinates() {
+    Graph graph;
+    ParsedData data = {0};
+    load_graph("data/graf.csrrg", &graph, &data);
+
+    // wiersz 0 jest pusty, wiersz 1 to wierzcholki 0..7, wiersz 2 to 8..10, ostatni wiersz 17 to 98..104
+    int known[][3] = {{0, 1, 3}, {7, 1, 15}, {8, 2, 10}, {10, 2, 15}, {11, 3, 4}, {98, 17, 2}, {104, 17, 14}};
+    assert(graph.coord_rows != NULL && graph.coord_cols != NULL && "Brak wspolrzednych wierzcholkow");
+    for (int i = 0; i < 7; i++) {
+        assert(graph.coord_rows[known[i][0]] == known[i][1] && "Nieprawidlowy wiersz wierzcholka");
+        assert(graph.coord_cols[known[i][0]] == known[i][2] && "Nieprawidlowa kolumna wierzcholka");
+    }
+    free(data.line1);
+    free(data.line2);
+    free(data.line3);
+    free(data.edges);
+    free(data.row_pointers);
+    free_graph(&graph);
+
+    // siatka 2 x 2 - poprawne wskazniki wierszy daja wspolrzedne, malejace lub niepelne nie daja zadnych
+    const char *row_pointers[] = {"0;2;4", "0;3;2;4", "0;2;3"};
+    for (int t = 0; t < 3; t++) {
+        const char *filename = "/tmp/test_grid_coordinates.csrrg";
+        FILE *file = fopen(filename, "w");
+        assert(file && "Nie mozna utworzyc pliku grafu");
+        fprintf(file, "2\n0;1;0;1\n%s\n1;2;0;3;0;3;1;2\n0;2;4;6\n", row_pointers[t]);
+        fclose(file);
+
+        ParsedData small_data = {0};
+        load_graph(filename, &graph, &small_data);
+        remove(filename);
+        if (t == 0) {
+            assert(graph.coord_rows != NULL && graph.coord_rows[3] == 1 && graph.coord_cols[3] == 1 &&
+                   graph.coord_rows[1] == 0 && graph.coord_cols[1] == 1 && "Nieprawidlowe wspolrzedne siatki 2 x 2");
+        } else {
+            assert(graph.coord_rows == NULL && graph.coord_cols == NULL && "Wspolrzedne z niespojnych wskaznikow wierszy");
+        }
+        free(small_data.line1);
+        free(small_data.line2);
+        free(small_data.line3);
+        free(small_data.edges);
+        free(small_data.row_pointers);
+        free_graph(&graph);
+    }
+
+    print_test_result("Test wspolrzednych wierzcholkow", 1);
+}
+
+// test podzialu strumieniowego - kazdy wierzcholek przypisany, czesci w pojemnosci, ciecie lepsze od losowego
+void test_stream_partition() {
+    Graph loaded;
+    ParsedData data = {0};
+    load_graph("data/graf.csrrg", &loaded, &data);
+    count_edges(&loaded);
+
+    int parts = 4;
+    float accuracy = 0.1;
+    Stream_scoring scorings[] = {STREAM_LDG, STREAM_FENNEL};
+    for (int t = 0; t < 2; t++) {
+        Graph graph;
+        assert(stream_partition("data/graf.csrrg", parts, accuracy, scorings[t], &graph) && "Nie udalo sie odczytac pliku");
+        assert(graph.vertices == loaded.vertices && "Nieprawidlowa liczba wierzcholkow");
+
+        int capacity = (int)((float)graph.vertices / parts * (1.0 + accuracy));
+        int total = 0;
+        for (int p = 0; p < parts; p++) {
+            assert(graph.part_sizes[p] <= capacity && "Czesc przekracza pojemnosc");
+            total += graph.part_sizes[p];
+        }
+        assert(total == graph.vertices && "Nie wszystkie wierzcholki sa przypisane");
+
+        const char *filename = "/tmp/test_stream_partition.part";
+        assert(write_part_file(filename, &graph) && "Nie udalo sie zapisac pliku .part");
+        Part_file file;
+        assert(open_part_file(filename, &file) && "Nie udalo sie otworzyc pliku .part");
+        for (int v = 0; v < graph.vertices; v++) {
+            assert(part_file_lookup(&file, v) == get_part_id(&graph, v) && "Nieprawidlowy wpis w pliku .part");
+        }
+        close_part_file(&file);
+        remove(filename);
+        free_graph(&graph);
+    }
+
+    // siatka zapisana jak pliki csrrg - krawedz tylko w grupie mniejszego wierzcholka, wiec wczesniejszych
+    // sasiadow wierzcholek zna tylko z glosow; samo przypisanie do najmniejszej czesci tnie polowe krawedzi
+    int side = 40;
+    const char *grid_path = "/tmp/test_stream_grid.csrrg";
+    FILE *file = fopen(grid_path, "w");
+    assert(file && "Nie mozna utworzyc pliku siatki");
+    fprintf(file, "%d\n", side);
+    for (int v = 0; v < side * side; v++) {
+        fprintf(file, v ? ";%d" : "%d", v % side);
+    }
+    fprintf(file, "\n");
+    for (int r = 0; r <= side; r++) {
+        fprintf(file, r ? ";%d" : "%d", r * side);
+    }
+    fprintf(file, "\n");
+    int entries = 0;
+    for (int v = 0; v < side * side; v++) {
+        if (v % side + 1 < side) {
+            fprintf(file, entries++ ? ";%d" : "%d", v + 1);
+        }
+        if (v + side < side * side) {
+            fprintf(file, entries++ ? ";%d" : "%d", v + side);
+        }
+    }
+    fprintf(file, "\n");
+    entries = 0;
+    for (int v = 0; v < side * side; v++) {
+        fprintf(file, v ? ";%d" : "%d", entries);
+        entries += (v % side + 1 < side) + (v + side < side * side);
+    }
+    fprintf(file, "\n");
+    fclose(file);
+
+    // przypisanie zawsze do najmniejszej czesci (remisy do mniejszego numeru)
+    int smallest_sizes[4] = {0};
+    int *smallest_parts = malloc(side * side * sizeof(int));
+    for (int v = 0; v < side * side; v++) {
+        int best = 0;
+        for (int p = 1; p < parts; p++) {
+            if (smallest_sizes[p] < smallest_sizes[best])
+                best = p;
+        }
+        smallest_parts[v] = best;
+        smallest_sizes[best]++;
+    }
+
+    for (int t = 0; t < 2; t++) {
+        Graph graph;
+        assert(stream_partition(grid_path, parts, accuracy, scorings[t], &graph) && "Nie udalo sie odczytac siatki");
+        int cut = 0;
+        int smallest_cut = 0;
+        int edges = 0;
+        for (int v = 0; v < side * side; v++) {
+            int neighbors[2] = {v % side + 1 < side ? v + 1 : -1, v + side < side * side ? v + side : -1};
+            for (int j = 0; j < 2; j++) {
+                if (neighbors[j] < 0)
+                    continue;
+                edges++;
+                cut += get_part_id(&graph, v) != get_part_id(&graph, neighbors[j]);
+                smallest_cut += smallest_parts[v] != smallest_parts[neighbors[j]];
+            }
+        }
+        printf("Ciecie siatki %dx%d (%s): %d z %d, najmniejsza czesc: %d\n", side, side,
+               t == 0 ? "ldg" : "fennel", cut, edges, smallest_cut);
+        assert(cut < smallest_cut / 2 && "Podzial strumieniowy nie korzysta z sasiadow z wczesniejszych grup");
+        free_graph(&graph);
+    }
+    free(smallest_parts);
+    remove(grid_path);
+
+    print_test_result("Test podzialu strumieniowego", 1);
+    free(data.line1);
+    free(data.line2);
+    free(data.line3);
+    free(data.edges);
+    free(data.row_pointers);
+    free_graph(&loaded);
 }
 
 void run_file_reader_tests() {
@@ -90,6 +300,9 @@ int main() {
     test_graph_operations();
     test_add_neighbor();
     test_partition();
+    test_part_file();
+    test_grid_coordinates();
+    test_stream_partition();
     
     printf("\n=== Koniec testow file reader===\n");
     return 0;
@@ -4,6 +4,7 @@
 #include "graph.h"
 #include "partition.h"
 #include "fm_optimization.h"
+#include "portfolio.h"
 
 // pomocnicza funkcja do tworzenia prostego grafu testowego
 Graph *create_test_graph(int vertices, int parts)
@@ -14,6 +15,12 @@ Graph *create_test_graph(int vertices, int parts)
     graph->nodes = malloc(vertices * sizeof(Node));
     graph->min_count = 1;        // minimalna liczba wierzchołków w partycji
     graph->max_count = vertices; // maksymalna liczba wierzchołków
+    graph->part_ids = NULL;
+    graph->part_sizes = NULL;
+    graph->sell = NULL;
+    graph->quotient = NULL;
+    graph->pinned = NULL;
+    initialize_part_ids(graph, parts); // gesta tablica przypisan
 
     // inicjalizacja wierzchołków
     for (int i = 0; i < vertices; i++)
@@ -21,7 +28,7 @@ Graph *create_test_graph(int vertices, int parts)
         graph->nodes[i].vertex = i;
         graph->nodes[i].neighbor_count = 0;
         graph->nodes[i].neighbors = malloc(vertices * sizeof(int)); // zapas miejsca
-        graph->nodes[i].part_id = i % parts;                        // równy podział na partie
+        set_part_id(graph, i, i % parts); // równy podział na partie
     }
 
     return graph;
@@ -50,6 +57,11 @@ void free_test_graph(Graph *graph)
         free(graph->nodes[i].neighbors);
     }
     free(graph->nodes);
+    free(graph->part_ids);
+    free(graph->part_sizes);
+    free_sell_graph(graph->sell);
+    free_quotient_graph(graph->quotient);
+    free(graph->pinned);
     free(graph);
 }
 
@@ -64,7 +76,7 @@ void test_is_partition_connected()
     // Ustawiamy wszystkie wierzchołki do partycji 0
     for (int i = 0; i < 6; i++)
     {
-        graph->nodes[i].part_id = 0;
+        set_part_id(graph, i, 0);
     }
 
     // Dodajemy krawędzie tworząc spójny podgraf
@@ -78,7 +90,7 @@ void test_is_partition_connected()
     assert(is_partition_connected(graph, 0) == 1);
 
     // Zmieniamy wierzchołek 3 na partycję 1, rozdzielając partycję 0
-    graph->nodes[3].part_id = 1;
+    set_part_id(graph, 3, 1);
 
     // Teraz partycja 0 nie powinna być spójna
     assert(is_partition_connected(graph, 0) == 0);
@@ -123,10 +135,10 @@ void test_calculate_gain()
     Graph *graph = create_test_graph(4, 2);
 
     // Wierzchołki 0,1 w partycji 0, wierzchołki 2,3 w partycji 1
-    graph->nodes[0].part_id = 0;
-    graph->nodes[1].part_id = 0;
-    graph->nodes[2].part_id = 1;
-    graph->nodes[3].part_id = 1;
+    set_part_id(graph, 0, 0);
+    set_part_id(graph, 1, 0);
+    set_part_id(graph, 2, 1);
+    set_part_id(graph, 3, 1);
 
     // Dodajemy krawędzie
     add_edge(graph, 0, 1); // wewnątrz partycji 0
@@ -180,10 +192,10 @@ void test_is_valid_move()
     graph->max_count = 3; // maksymalna liczba wierzchołków
 
     // Wierzchołki 0,1 w partycji 0, wierzchołki 2,3 w partycji 1
-    graph->nodes[0].part_id = 0;
-    graph->nodes[1].part_id = 0;
-    graph->nodes[2].part_id = 1;
-    graph->nodes[3].part_id = 1;
+    set_part_id(graph, 0, 0);
+    set_part_id(graph, 1, 0);
+    set_part_id(graph, 2, 1);
+    set_part_id(graph, 3, 1);
 
     // Inicjalizujemy kontekst FM
     Partition_data *partition_data = malloc(sizeof(Partition_data));
@@ -209,7 +221,150 @@ void test_is_valid_move()
     free_test_graph(graph);
 }
 
+// test kernela zysku dla wszystkich szerokosci tablicy przypisan
+void test_gain_kernel_widths()
+{
+    printf("Test: gain_kernel\n");
+
+    // liczby czesci wymuszajace tablice 8-, 16- i 32-bitowa
+    int part_counts[] = {3, 300, 70000};
+    for (int c = 0; c < 3; c++)
+    {
+        // gwiazda: wierzcholek 0 ma 37 sasiadow, wiecej niz jeden wektor i niepelna koncowka
+        Graph *graph = create_test_graph(38, part_counts[c]);
+        for (int i = 1; i < 38; i++)
+        {
+            add_edge(graph, 0, i);
+            set_part_id(graph, i, (i * 7) % 3);
+        }
+        set_part_id(graph, 37, -1); // sasiad bez przypisania
+
+        for (int target = 0; target < 3; target++)
+        {
+            int expected = gain_kernel_scalar(graph, graph->nodes[0].neighbors,
+                                              graph->nodes[0].neighbor_count, 0, target);
+            int actual = gain_kernel(graph, graph->nodes[0].neighbors,
+                                     graph->nodes[0].neighbor_count, 0, target);
+            assert(expected == actual);
+        }
+        free_test_graph(graph);
+    }
+
+    printf("OK\n");
+}
+
 // główna funkcja testująca
+// porownuje graf ilorazowy aktualizowany ruchami z grafem zbudowanym od nowa
+static void assert_quotient_matches(Graph *graph)
+{
+    Quotient_graph *fresh = build_quotient_graph(graph);
+    Quotient_graph *current = graph->quotient;
+
+    assert(current->total_cut == fresh->total_cut);
+    for (int p = 0; p < graph->parts; p++)
+    {
+        assert(current->degree[p] == fresh->degree[p]);
+        assert(current->boundary_count[p] == fresh->boundary_count[p]);
+        for (int r = 0; r < graph->parts; r++)
+        {
+            assert(quotient_cut_weight(current, p, r) == quotient_cut_weight(fresh, p, r));
+        }
+    }
+    for (int v = 0; v < graph->vertices; v++)
+    {
+        assert(current->external_degree[v] == fresh->external_degree[v]);
+    }
+    free_quotient_graph(fresh);
+}
+
+// test aktualizacji grafu ilorazowego przy ruchach wierzcholkow
+void test_quotient_graph_updates()
+{
+    printf("Test: quotient graph updates\n");
+
+    // pierscien z cieciwami podzielony na 4 czesci
+    Graph *graph = create_test_graph(40, 4);
+    for (int i = 0; i < 40; i++)
+    {
+        add_edge(graph, i, (i + 1) % 40);
+        if (i % 5 == 0)
+            add_edge(graph, i, (i + 13) % 40);
+    }
+    for (int i = 0; i < 40; i++)
+    {
+        set_part_id(graph, i, i / 10);
+    }
+
+    graph->quotient = build_quotient_graph(graph);
+    assert(quotient_cut_weight(graph->quotient, 0, 1) == quotient_cut_weight(graph->quotient, 1, 0));
+    assert(graph->quotient->adjacent[0] != NULL);
+
+    // ruchy przez set_part_id, takze zdjecie przypisania i powrot
+    int moves[][2] = {{9, 1}, {10, 0}, {25, 3}, {0, -1}, {0, 2}, {13, 2}, {13, 1}, {39, 0}};
+    for (int m = 0; m < 8; m++)
+    {
+        set_part_id(graph, moves[m][0], moves[m][1]);
+        assert_quotient_matches(graph);
+    }
+
+    // wszystkie wierzcholki znowu maja czesc, wiec liczba przeciec zgadza sie z pelnym zliczeniem
+    assert(graph->quotient->total_cut == count_cut_edges(graph));
+
+    printf("OK\n");
+    free_test_graph(graph);
+}
+
+void test_portfolio_restarts()
+{
+    printf("Test: portfolio of restarts\n");
+
+    // siatka 30 x 30 podzielona na 4 czesci w kilku probach
+    int side = 30;
+    Graph *graph = create_test_graph(side * side, 4);
+    for (int r = 0; r < side; r++)
+    {
+        for (int c = 0; c < side; c++)
+        {
+            int v = r * side + c;
+            if (c + 1 < side)
+                add_edge(graph, v, v + 1);
+            if (r + 1 < side)
+                add_edge(graph, v, v + side);
+        }
+    }
+    graph->min_count = side * side / 4 * 9 / 10;
+    graph->max_count = side * side / 4 * 11 / 10;
+
+    Portfolio_settings settings = {6, 100, 0, 0.1, 1234};
+    Partition_data partition_data;
+    initialize_partition_data(&partition_data, 4);
+
+    set_thread_count(3);
+    Portfolio_result first = run_portfolio(graph, 4, &partition_data, &settings);
+    int *assignment = malloc(side * side * sizeof(int));
+    for (int v = 0; v < side * side; v++)
+        assignment[v] = get_part_id(graph, v);
+    assert(first.best_trial >= 0 && first.best_cut == count_cut_edges(graph));
+
+    // to samo ziarno daje ten sam wynik niezaleznie od liczby watkow
+    set_thread_count(1);
+    Portfolio_result second = run_portfolio(graph, 4, &partition_data, &settings);
+    assert(second.best_trial == first.best_trial && second.best_cut == first.best_cut);
+    for (int v = 0; v < side * side; v++)
+        assert(get_part_id(graph, v) == assignment[v]);
+
+    // najlepsza proba nie jest gorsza od pojedynczej proby z tym samym ziarnem
+    settings.restarts = 1;
+    Portfolio_result single = run_portfolio(graph, 4, &partition_data, &settings);
+    assert(!single.balanced || first.best_cut <= single.best_cut);
+
+    printf("OK\n");
+    release_thread_pool();
+    free(assignment);
+    free_partition_data(&partition_data, 4);
+    free_test_graph(graph);
+}
+
 int main()
 {
     printf("====== Testy FM Optimization ======\n");
@@ -218,6 +373,9 @@ int main()
     test_will_remain_connected_if_removed();
     test_calculate_gain();
     test_is_valid_move();
+    test_gain_kernel_widths();
+    test_quotient_graph_updates();
+    test_portfolio_restarts();
 
     printf("\nWszystkie testy zakończone pomyślnie!\n");
     return 0;
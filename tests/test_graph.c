@@ -2,6 +2,8 @@
 #include <assert.h>
 #include "graph.h"
 #include "file_reader.h"
+#include "msbfs.h"
+#include "sell_graph.h"
 
 // test inicjalizacji grafu
 void test_graph_initialization() {
@@ -21,7 +23,7 @@ void test_graph_initialization() {
     for (int i = 0; i < test_vertices; i++) {
         assert(graph.nodes[i].vertex == i && "Nieprawidlowy indeks wierzcholka");
         assert(graph.nodes[i].neighbor_count == 0 && "Poczatkowa liczba sasiadow powinna byc 0");
-        assert(graph.nodes[i].part_id == -1 && "Poczatkowe ID partycji powinno byc -1");
+        assert(get_part_id(&graph, i) == -1 && "Poczatkowe ID partycji powinno byc -1");
     }
     
     printf("Test inicjalizacji grafu: OK\n");
@@ -74,12 +76,108 @@ void test_partition_parameters() {
     free_graph(&graph);
 }
 
+// test wielozrodlowego BFS na sciezce, gdzie odleglosci sa znane
+void test_multi_source_bfs() {
+    Graph graph;
+    int n = 300;
+    inicialize_graph(&graph, n);
+    for (int i = 0; i + 1 < n; i++) {
+        add_neighbor(&graph.nodes[i], i + 1);
+        add_neighbor(&graph.nodes[i + 1], i);
+    }
+
+    // wiecej zrodel niz miesci sie w jednym przebiegu
+    int sources[n];
+    int eccentricity[n];
+    for (int i = 0; i < n; i++) {
+        sources[i] = i;
+    }
+
+    Msbfs_state *state = create_msbfs_state(n);
+    int diameter = estimate_pseudo_diameter(&graph, state, sources, n, eccentricity);
+    assert(diameter == n - 1 && "Nieprawidlowa srednica sciezki");
+    for (int i = 0; i < n; i++) {
+        int expected = i > n - 1 - i ? i : n - 1 - i;
+        assert(eccentricity[i] == expected && "Nieprawidlowa ekscentrycznosc");
+    }
+
+    // cele na obu koncach sciezki
+    unsigned char is_target[300] = {0};
+    is_target[0] = 1;
+    is_target[n - 1] = 1;
+    int distances[n];
+    nearest_target_distances(&graph, state, sources, n, is_target, distances);
+    for (int i = 0; i < n; i++) {
+        int expected = i < n - 1 - i ? i : n - 1 - i;
+        assert(distances[i] == expected && "Nieprawidlowa odleglosc do celu");
+    }
+
+    printf("Test wielozrodlowego BFS: OK\n");
+    free_msbfs_state(state);
+    free_graph(&graph);
+}
+
+// test jadra SELL-C-sigma wzgledem zwyklego przejscia po listach
+void test_sell_kernels() {
+    Graph graph;
+    int n = 500;
+    inicialize_graph(&graph, n);
+    for (int i = 0; i + 1 < n; i++) {
+        add_neighbor(&graph.nodes[i], i + 1);
+        add_neighbor(&graph.nodes[i + 1], i);
+        // rozne stopnie, zeby plastry mialy dopelnienie
+        if (i % 3 == 0 && i + 7 < n) {
+            add_neighbor(&graph.nodes[i], i + 7);
+            add_neighbor(&graph.nodes[i + 7], i);
+        }
+    }
+
+    // 300 czesci wymusza tablice 16-bitowa
+    assing_parts(&graph, 300);
+    for (int i = 0; i < n; i++) {
+        set_part_id(&graph, i, (i / 4) % 300);
+    }
+
+    Sell_graph *sell = build_sell_graph(&graph);
+    int internal[500];
+    sell_internal_degrees(&graph, sell, internal);
+    int cut = 0;
+    for (int i = 0; i < n; i++) {
+        int expected = 0;
+        for (int j = 0; j < graph.nodes[i].neighbor_count; j++) {
+            int neighbor = graph.nodes[i].neighbors[j];
+            if (get_part_id(&graph, neighbor) == get_part_id(&graph, i))
+                expected++;
+            else if (i < neighbor)
+                cut++;
+        }
+        assert(internal[i] == expected && "Nieprawidlowy stopien wewnetrzny");
+    }
+    assert(sell_count_cut_edges(&graph, sell) == cut && "Nieprawidlowa liczba przeciec");
+    free_sell_graph(sell);
+
+    // gwiazda ma zbyt duzy rozrzut stopni na uklad SELL
+    Graph star;
+    inicialize_graph(&star, 40);
+    for (int i = 1; i < 40; i++) {
+        add_neighbor(&star.nodes[0], i);
+        add_neighbor(&star.nodes[i], 0);
+    }
+    assert(build_sell_graph_if_suitable(&star) == NULL && "Gwiazda nie powinna dostac ukladu SELL");
+
+    printf("Test jadra SELL: OK\n");
+    free_graph(&star);
+    free_graph(&graph);
+}
+
 int main() {
     printf("=== Testy Graph ===\n\n");
     
     test_graph_initialization();
     test_edge_operations();
     test_partition_parameters();
+    test_multi_source_bfs();
+    test_sell_kernels();
     
     printf("\n=== Wszystkie testy grafu zakonczone ===\n");
     return 0;
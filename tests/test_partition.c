@@ -3,6 +3,8 @@
 #include "partition.h"
 #include "graph.h"
 #include "file_reader.h"  // for add_neighbor function
+#include "halo.h"
+#include "subgraph.h"
 
 // test inicjalizacji struktury partycji
 void test_partition_initialization() {
@@ -19,28 +21,30 @@ void test_partition_initialization() {
     for (int i = 0; i < parts; i++) {
         assert(partition_data.parts[i].part_id == i && "Nieprawidlowe ID czesci");
         assert(partition_data.parts[i].part_vertex_count == 0 && "Poczatkowa liczba wierzcholkow powinna byc 0");
-        assert(partition_data.parts[i].capacity == 0 && "Poczatkowa pojemnosc powinna byc 0");
+        assert(partition_data.parts[i].part_vertexes == NULL && "Lista czesci nie powinna jeszcze istniec");
     }
     
     printf("Test inicjalizacji partycji: OK\n");
     free_partition_data(&partition_data, parts);
 }
 
-// test dodawania wierzcholkow do partycji
+// test odtwarzania list czesci z tablicy przypisan grafu
 void test_vertex_assignment() {
+    Graph graph;
     Partition_data partition_data;
     int parts = 2;
     
+    inicialize_graph(&graph, 6);
+    assing_parts(&graph, parts);
     initialize_partition_data(&partition_data, parts);
     
-    // dodaj wierzcholki do pierwszej czesci
-    add_partition_data(&partition_data, 0, 1);
-    add_partition_data(&partition_data, 0, 2);
-    add_partition_data(&partition_data, 0, 3);
-    
-    // dodaj wierzcholki do drugiej czesci
-    add_partition_data(&partition_data, 1, 4);
-    add_partition_data(&partition_data, 1, 5);
+    // wierzcholki 1, 2, 3 w pierwszej czesci, 4, 5 w drugiej, 0 bez przypisania
+    set_part_id(&graph, 1, 0);
+    set_part_id(&graph, 2, 0);
+    set_part_id(&graph, 3, 0);
+    set_part_id(&graph, 4, 1);
+    set_part_id(&graph, 5, 1);
+    rebuild_partition_data(&partition_data, &graph);
     
     // sprawdz liczbe wierzcholkow w czesciach
     assert(partition_data.parts[0].part_vertex_count == 3 && "Nieprawidlowa liczba wierzcholkow w pierwszej czesci");
@@ -53,8 +57,16 @@ void test_vertex_assignment() {
     assert(partition_data.parts[1].part_vertexes[0] == 4 && "Nieprawidlowy pierwszy wierzcholek w czesci 1");
     assert(partition_data.parts[1].part_vertexes[1] == 5 && "Nieprawidlowy drugi wierzcholek w czesci 1");
     
+    // przeniesienie w grafie jest widoczne po odtworzeniu, bez osobnej aktualizacji list
+    set_part_id(&graph, 3, 1);
+    rebuild_partition_data(&partition_data, &graph);
+    assert(partition_data.parts[0].part_vertex_count == 2 && "Lista czesci 0 nie nadaza za grafem");
+    assert(partition_data.parts[1].part_vertexes[0] == 3 && "Lista czesci 1 nie nadaza za grafem");
+    assert(partition_data.offsets[2] == 5 && "Nieprawidlowe przesuniecia czesci");
+    
     printf("Test przypisywania wierzcholkow: OK\n");
     free_partition_data(&partition_data, parts);
+    free_graph(&graph);
 }
 
 // test znajdowania sasiadow w partycji
@@ -77,38 +89,118 @@ void test_partition_neighbors() {
     add_neighbor(&graph.nodes[4], 5);
     add_neighbor(&graph.nodes[5], 4);
     
-    // przypisz wierzcholki do partycji
-    add_partition_data(&partition_data, 0, 0);
-    add_partition_data(&partition_data, 0, 1);
-    add_partition_data(&partition_data, 0, 2);
-    add_partition_data(&partition_data, 1, 3);
-    add_partition_data(&partition_data, 1, 4);
-    add_partition_data(&partition_data, 1, 5);
+    // przypisz wierzcholki do partycji w grafie, listy czesci sa z niego odtwarzane
+    assing_parts(&graph, parts);
+    for (int i = 0; i < 6; i++) {
+        set_part_id(&graph, i, i < 3 ? 0 : 1);
+    }
+    rebuild_partition_data(&partition_data, &graph);
+    assert(partition_data.parts[1].part_vertex_count == 3 && "Nieprawidlowo odtworzona czesc 1");
+    assert(is_in_partition(&graph, 1, 4) && !is_in_partition(&graph, 0, 4) && "Nieprawidlowa przynaleznosc");
     
     // znajdz sasiadow w pierwszej czesci
-    int size;
-    int **neighbors = get_part_neighbors(&graph, &partition_data, 0, &size);
+    Part_neighbors neighbors;
+    int ok = get_part_neighbors(&graph, &partition_data, 0, &neighbors);
     
-    assert(neighbors != NULL && "Tablica sasiadow nie zostala zaalokowana");
-    assert(size == 3 && "Nieprawidlowa liczba wierzcholkow z sasiadami");
+    assert(ok && "Sasiedztwo czesci nie zostalo utworzone");
+    assert(neighbors.size == 3 && "Nieprawidlowa liczba wierzcholkow z sasiadami");
+    assert(neighbors.vertices[1] == 1 && "Nieprawidlowy wierzcholek 1");
+    assert(neighbors.offsets[2] - neighbors.offsets[1] == 2 && "Nieprawidlowa liczba sasiadow wierzcholka 1");
+    assert(neighbors.neighbors[neighbors.offsets[1]] == 0 && neighbors.neighbors[neighbors.offsets[1] + 1] == 2 &&
+           "Nieprawidlowi sasiedzi wierzcholka 1");
+    assert(neighbors.offsets[neighbors.size] == 4 && "Nieprawidlowa liczba krawedzi wewnatrz czesci");
     
     // zwolnij pamiec
-    for (int i = 0; i < size; i++) {
-        free(neighbors[i]);
-    }
-    free(neighbors);
+    free_part_neighbors(&neighbors);
     free_partition_data(&partition_data, parts);
     free_graph(&graph);
     
     printf("Test znajdowania sasiadow w partycji: OK\n");
 }
 
+// test brzegu i halo czesci na sciezce 0-1-2-3-4-5
+void test_halo_layer() {
+    Graph graph;
+    int parts = 2;
+    
+    inicialize_graph(&graph, 6);
+    for (int i = 0; i < 5; i++) {
+        add_neighbor(&graph.nodes[i], i + 1);
+        add_neighbor(&graph.nodes[i + 1], i);
+    }
+    assing_parts(&graph, parts);
+    for (int i = 0; i < 6; i++) {
+        set_part_id(&graph, i, i < 3 ? 0 : 1);
+    }
+    
+    // halo glebokosci 2: czesc 0 widzi 3 i 4, czesc 1 widzi 2 i 1
+    Halo_layer layer;
+    build_halo_layer(&graph, parts, 2, &layer);
+    const Part_halo *halo = &layer.halos[0];
+    assert(halo->boundary_count == 1 && halo->boundary[0] == 2 && "Nieprawidlowy brzeg czesci 0");
+    assert(halo->ghost_count == 2 && "Nieprawidlowa liczba duchow czesci 0");
+    assert(halo->ghosts[0] == 3 && halo->ghost_hop[0] == 1 && halo->ghost_owner[0] == 1 && "Nieprawidlowy duch 3");
+    assert(halo->ghosts[1] == 4 && halo->ghost_hop[1] == 2 && "Nieprawidlowy duch 4");
+    assert(halo->edge_count == 2 && "Nieprawidlowa liczba krawedzi halo");
+    assert(halo->edges[0] == 2 && halo->edges[1] == 3 && "Brak krawedzi przecietej 2-3");
+    assert(halo->edges[2] == 4 && halo->edges[3] == 3 && "Brak krawedzi miedzy duchami 3-4");
+    assert(layer.halos[1].boundary[0] == 3 && layer.halos[1].ghosts[1] == 1 && "Nieprawidlowe halo czesci 1");
+    free_halo_layer(&layer);
+    
+    // przy glebokosci 1 zostaja tylko sasiedzi zewnetrzni
+    build_halo_layer(&graph, parts, 1, &layer);
+    assert(layer.halos[0].ghost_count == 1 && layer.halos[0].edge_count == 1 && "Halo wykracza poza glebokosc 1");
+    free_halo_layer(&layer);
+    free_graph(&graph);
+    
+    printf("Test warstwy duchow: OK\n");
+}
+
+// test wydzielania podgrafow z numeracja lokalna
+void test_subgraph_extraction() {
+    Graph graph;
+    int parts = 2;
+    
+    // sciezka 0-1-2-3-4-5, czesc 0 to wierzcholki parzyste poza 4 plus 5
+    inicialize_graph(&graph, 6);
+    for (int i = 0; i < 5; i++) {
+        add_neighbor(&graph.nodes[i], i + 1);
+        add_neighbor(&graph.nodes[i + 1], i);
+    }
+    assing_parts(&graph, parts);
+    int assignment[] = {0, 0, 1, 1, 0, 0};
+    for (int i = 0; i < 6; i++) {
+        set_part_id(&graph, i, assignment[i]);
+    }
+    
+    Subgraph_set set;
+    extract_subgraphs(&graph, parts, &set);
+    const Part_subgraph *first = &set.subgraphs[0];
+    assert(first->vertices == 4 && "Nieprawidlowa liczba wierzcholkow czesci 0");
+    assert(first->local_to_global[2] == 4 && set.global_to_local[4] == 2 && "Nieprawidlowa numeracja lokalna");
+    assert(first->offsets[4] == 4 && "Nieprawidlowa liczba krawedzi wewnetrznych czesci 0");
+    assert(first->offsets[2] - first->offsets[1] == 1 && first->neighbors[first->offsets[1]] == 0 &&
+           "Krawedz przecieta 1-2 nie zostala pominieta");
+    assert(first->neighbors[first->offsets[3]] == 2 && "Nieprawidlowy lokalny sasiad wierzcholka 5");
+    
+    const Part_subgraph *second = &set.subgraphs[1];
+    assert(second->vertices == 2 && second->neighbors[0] == 1 && second->neighbors[1] == 0 &&
+           "Nieprawidlowy podgraf czesci 1");
+    
+    free_subgraphs(&set);
+    free_graph(&graph);
+    
+    printf("Test wydzielania podgrafow: OK\n");
+}
+
 int main() {
     printf("=== Testy partycji ===\n\n");
     
     test_partition_initialization();
     test_vertex_assignment();
     test_partition_neighbors();
+    test_halo_layer();
+    test_subgraph_extraction();
     
     printf("\n=== Wszystkie testy partycji zakonczone ===\n");
     return 0;
@@ -1,9 +1,40 @@
 #include <stdio.h>
 #include <assert.h>
 #include "region_growing.h"
+#include "spectral.h"
+#include "exact.h"
+#include "recursive_bisection.h"
 #include "graph.h"
 #include "partition.h"
 #include "file_reader.h"
+#include "fm_optimization.h"
+
+// siatka side x side, wierzcholek r * side + c ma sasiadow w prawo i w dol (krawedzie w obie strony)
+static void build_grid(Graph *graph, int side) {
+    inicialize_graph(graph, side * side);
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int v = r * side + c;
+            if (c + 1 < side) {
+                add_neighbor(&graph->nodes[v], v + 1);
+                add_neighbor(&graph->nodes[v + 1], v);
+            }
+            if (r + 1 < side) {
+                add_neighbor(&graph->nodes[v], v + side);
+                add_neighbor(&graph->nodes[v + side], v);
+            }
+        }
+    }
+}
+
+// sciezka 0-1-...-(n-1)
+static void build_path(Graph *graph, int n) {
+    inicialize_graph(graph, n);
+    for (int i = 0; i + 1 < n; i++) {
+        add_neighbor(&graph->nodes[i], i + 1);
+        add_neighbor(&graph->nodes[i + 1], i);
+    }
+}
 
 // test dla malego grafu o znanej strukturze
 void test_small_region_growing() {
@@ -74,11 +105,431 @@ void test_file_region_growing() {
     free_partition_data(&partition_data, 3);
 }
 
+// test rownoleglego sprawdzania spojnosci na duzej siatce
+void test_parallel_connectivity() {
+    Graph graph;
+    int side = 200; // 40000 wierzcholkow, powyzej progu sprawdzania rownoleglego
+
+    build_grid(&graph, side);
+
+    // 4 pasy kolumn, pas 3 jest przeciety wierszem nalezacym do pasa 0
+    assing_parts(&graph, 4);
+    for (int v = 0; v < side * side; v++) {
+        set_part_id(&graph, v, (v % side) / (side / 4));
+    }
+    for (int c = 3 * side / 4; c < side; c++) {
+        set_part_id(&graph, (side / 2) * side + c, 0);
+    }
+
+    set_thread_count(4);
+    int connected[4];
+    int all = check_all_parts_connected(&graph, 4, connected);
+
+    // wynik musi sie zgadzac z prostym BFS dla kazdej czesci
+    for (int p = 0; p < 4; p++) {
+        assert(connected[p] == verify_partition_connectivity(&graph, p) && "Niezgodny wynik spojnosci");
+    }
+    assert(!all && !connected[0] && connected[1] && connected[2] && !connected[3] && "Zly wynik spojnosci");
+
+    printf("\nTest rownoleglego sprawdzania spojnosci: OK\n");
+    release_thread_pool();
+    free_graph(&graph);
+}
+
+// test przypietych wierzcholkow - sa punktami startowymi i FM ich nie przenosi
+void test_pinned_vertices() {
+    Graph graph;
+    Partition_data partition_data;
+    int side = 20;
+    int parts = 4;
+
+    build_grid(&graph, side);
+
+    // naroznik i srodek przypiete do czesci 2, pozostale narozniki do innych
+    const char *pin_path = "/tmp/test_region_growing.pins";
+    FILE *file = fopen(pin_path, "w");
+    assert(file && "Nie mozna utworzyc pliku przypiec");
+    fprintf(file, "# wierzcholek czesc\n0 2\n19;0\n380,3\n399 1\n210 2\n");
+    fclose(file);
+
+    assing_parts(&graph, parts);
+    assert(load_pin_file(pin_path, &graph) == 5 && "Nieprawidlowa liczba przypiec");
+    remove(pin_path);
+
+    int pinned[][2] = {{0, 2}, {19, 0}, {380, 3}, {399, 1}, {210, 2}};
+    initialize_partition_data(&partition_data, parts);
+    region_growing(&graph, parts, &partition_data, 0.2);
+    for (int i = 0; i < 5; i++) {
+        assert(get_part_id(&graph, pinned[i][0]) == pinned[i][1] && "Przypiety wierzcholek w zlej czesci po rozroscie");
+    }
+
+    cut_edges_optimization(&graph, &partition_data, 50);
+    for (int i = 0; i < 5; i++) {
+        assert(get_part_id(&graph, pinned[i][0]) == pinned[i][1] && "FM przeniosl przypiety wierzcholek");
+    }
+
+    printf("Test przypietych wierzcholkow: OK\n");
+    free_graph(&graph);
+    free_partition_data(&partition_data, parts);
+}
+
+// test sasiednich przypietych wierzcholkow w roznych czesciach - drugi punkt startowy jest juz we
+// froncie pierwszego i nie moze zostac przypisany drugi raz
+void test_adjacent_pinned_vertices() {
+    Graph graph;
+    Partition_data partition_data;
+    int n = 10;
+
+    build_path(&graph, n);
+    count_edges(&graph);
+    assing_parts(&graph, 2);
+    graph.pinned = malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        graph.pinned[i] = -1;
+    }
+    graph.pinned[0] = 0;
+    graph.pinned[1] = 1;
+
+    initialize_partition_data(&partition_data, 2);
+    region_growing(&graph, 2, &partition_data, 0.5);
+    assert(get_part_id(&graph, 0) == 0 && "Przypiety wierzcholek 0 w zlej czesci");
+    assert(get_part_id(&graph, 1) == 1 && "Przypiety wierzcholek 1 w zlej czesci");
+    assert(graph.part_sizes[0] + graph.part_sizes[1] == n && "Rozmiary czesci nie sumuja sie do liczby wierzcholkow");
+
+    printf("Test sasiednich przypietych wierzcholkow: OK\n");
+    free_graph(&graph);
+    free_partition_data(&partition_data, 2);
+}
+
+// test podzialu na bardzo wiele czesci - kazda czesc ma dostac wierzcholki
+void test_many_parts() {
+    Graph graph;
+    Partition_data partition_data;
+    int side = 60;
+    int parts = 600;
+
+    build_grid(&graph, side);
+
+    initialize_partition_data(&partition_data, parts);
+    region_growing(&graph, parts, &partition_data, 0.5);
+
+    int total = 0;
+    for (int p = 0; p < parts; p++) {
+        assert(graph.part_sizes[p] > 0 && "Pusta czesc przy duzej liczbie czesci");
+        total += graph.part_sizes[p];
+    }
+    for (int v = 0; v < side * side; v++) {
+        assert(get_part_id(&graph, v) >= 0 && "Nieprzypisany wierzcholek");
+    }
+    assert(total == side * side && "Nieprawidlowa suma rozmiarow czesci");
+
+    printf("Test podzialu na wiele czesci: OK\n");
+    free_graph(&graph);
+    free_partition_data(&partition_data, parts);
+}
+
+// test rownoleglego rozrostu - czesci rosna naraz na kilku watkach
+void test_parallel_region_growing() {
+    Graph graph;
+    Partition_data partition_data;
+    int side = 200; // 40000 wierzcholkow, powyzej progu uzycia puli
+    int parts = 8;
+
+    build_grid(&graph, side);
+
+    set_thread_count(4);
+    initialize_partition_data(&partition_data, parts);
+    parallel_region_growing(&graph, parts, &partition_data, 0.1);
+
+    // rozmiary w grafie musza sie zgadzac z tablica przypisan
+    int counts[8] = {0};
+    for (int v = 0; v < side * side; v++) {
+        int part = get_part_id(&graph, v);
+        assert(part >= 0 && part < parts && "Nieprzypisany wierzcholek po rozroscie rownoleglym");
+        counts[part]++;
+    }
+    for (int p = 0; p < parts; p++) {
+        assert(counts[p] == graph.part_sizes[p] && "Niezgodne rozmiary czesci");
+        assert(partition_data.parts[p].part_vertex_count == counts[p] && "Niezgodne listy czesci");
+    }
+    assert(check_all_parts_connected(&graph, parts, NULL) && "Niespojna czesc po rozroscie rownoleglym");
+
+    printf("Test rownoleglego rozrostu regionow: OK\n");
+    release_thread_pool();
+    free_graph(&graph);
+    free_partition_data(&partition_data, parts);
+}
+
+// test wyboru punktow startowych k-center na sciezce - punkty trafiaja na jej konce
+void test_farthest_seeds() {
+    Graph graph;
+    int n = 100;
+
+    build_path(&graph, n);
+
+    assing_parts(&graph, 3);
+    set_seeding_mode(SEEDING_KCENTER);
+    int *seeds = generate_seed_points(&graph, 3);
+    int low = seeds[0] < seeds[1] ? seeds[0] : seeds[1];
+    int high = seeds[0] < seeds[1] ? seeds[1] : seeds[0];
+    assert(low == 0 && high == n - 1 && "Pierwsze dwa punkty powinny lezec na koncach sciezki");
+    assert((seeds[2] == 49 || seeds[2] == 50) && "Trzeci punkt powinien lezec w srodku sciezki");
+    free(seeds);
+
+    // losowanie D^2 tez daje rozne punkty
+    assing_parts(&graph, 10);
+    set_seeding_mode(SEEDING_D2);
+    seeds = generate_seed_points(&graph, 10);
+    for (int i = 0; i < 10; i++) {
+        for (int j = i + 1; j < 10; j++) {
+            assert(seeds[i] != seeds[j] && "Powtorzony punkt startowy");
+        }
+    }
+    free(seeds);
+    set_seeding_mode(SEEDING_KCENTER);
+
+    printf("Test wyboru najdalszych punktow startowych: OK\n");
+    free_graph(&graph);
+}
+
+// test naprawy spojnosci - odcieta skladowa trafia do sasiedniej czesci
+void test_connectivity_repair() {
+    Graph graph;
+    int n = 12;
+
+    // odcieta skladowa {7} czesci 0 rozdziela czesc 1
+    build_path(&graph, n);
+    assing_parts(&graph, 3);
+    int assignment[] = {0, 0, 0, 0, 1, 1, 1, 0, 1, 1, 2, 2};
+    int part_counts[3] = {0};
+    for (int i = 0; i < n; i++) {
+        set_part_id(&graph, i, assignment[i]);
+        part_counts[assignment[i]]++;
+    }
+
+    // zdjete zostaja {7} z czesci 0 i mniejsza skladowa {8, 9} czesci 1
+    int moved = repair_partition_connectivity(&graph, 3, part_counts);
+    assert(moved == 3 && "Nieprawidlowa liczba zdjetych wierzcholkow");
+    assert(get_part_id(&graph, 7) == 1 && "Wierzcholek 7 powinien trafic do czesci 1");
+    assert(get_part_id(&graph, 9) == 2 && "Wierzcholek 9 powinien trafic do czesci 2");
+    assert(get_part_id(&graph, 8) == 2 && "Wierzcholek 8 powinien trafic do mniejszej czesci 2");
+    assert(part_counts[0] == 4 && part_counts[1] == 4 && part_counts[2] == 4 && "Nieprawidlowe liczniki czesci");
+    assert(check_all_parts_connected(&graph, 3, NULL) && "Czesci nadal niespojne");
+
+    printf("Test naprawy spojnosci: OK\n");
+    free_graph(&graph);
+}
+
+// test podzialu geometrycznego siatki - rowne i spojne czesci
+void test_geometric_partition() {
+    Graph graph;
+    Partition_data partition_data;
+    int side = 20;
+    int n = side * side;
+    int parts = 4;
+
+    // krzywa rzedu 1 odwiedza cwiartki w kolejnosci (0,0), (1,0), (1,1), (0,1)
+    assert(hilbert_index(1, 0, 0) == 0 && hilbert_index(1, 1, 0) == 1 && "Zla kolejnosc krzywej Hilberta");
+    assert(hilbert_index(1, 1, 1) == 2 && hilbert_index(1, 0, 1) == 3 && "Zla kolejnosc krzywej Hilberta");
+
+    Geometric_mode modes[] = {GEOMETRIC_HILBERT, GEOMETRIC_RCB};
+    for (int m = 0; m < 2; m++) {
+        build_grid(&graph, side);
+        graph.coord_rows = malloc(n * sizeof(int));
+        graph.coord_cols = malloc(n * sizeof(int));
+        for (int v = 0; v < n; v++) {
+            graph.coord_rows[v] = v / side;
+            graph.coord_cols[v] = v % side;
+        }
+        count_edges(&graph);
+        initialize_partition_data(&partition_data, parts);
+
+        int success = geometric_partition(&graph, parts, &partition_data, 0.1, modes[m]);
+        assert(success && "Podzial geometryczny poza dokladnoscia");
+        for (int p = 0; p < parts; p++) {
+            assert(partition_data.parts[p].part_vertex_count == n / parts && "Nierowne czesci siatki");
+        }
+        assert(check_all_parts_connected(&graph, parts, NULL) && "Czesci geometryczne niespojne");
+
+        free_partition_data(&partition_data, parts);
+        free_graph(&graph);
+    }
+
+    printf("Test podzialu geometrycznego: OK\n");
+}
+
+// test bisekcji spektralnej - sciezka dzieli sie jednym cieciem, siatka na rowne spojne czesci
+void test_spectral_partition() {
+    Graph graph;
+    Partition_data partition_data;
+    int n = 100;
+
+    build_path(&graph, n);
+    count_edges(&graph);
+
+    // laplasjan zeruje wektor staly, a na sciezce liczy roznice z sasiadami
+    int *vertices = malloc(n * sizeof(int));
+    int *local = malloc(n * sizeof(int));
+    double *x = malloc(n * sizeof(double));
+    double *y = malloc(n * sizeof(double));
+    for (int v = 0; v < n; v++) {
+        vertices[v] = v;
+        local[v] = -1;
+        x[v] = v * v;
+    }
+    Laplacian laplacian;
+    build_laplacian(&graph, vertices, n, local, &laplacian);
+    laplacian_multiply(&laplacian, x, y);
+    assert(y[0] == -1.0 && y[n - 1] == (double)(n - 1) * (n - 1) - (n - 2) * (n - 2) && "Zly wynik mnozenia");
+    for (int v = 1; v + 1 < n; v++) {
+        assert(y[v] == -2.0 && "Zly wynik mnozenia");
+    }
+    free_laplacian(&laplacian);
+    free(vertices);
+    free(local);
+    free(x);
+    free(y);
+
+    initialize_partition_data(&partition_data, 2);
+    assert(spectral_partition(&graph, 2, &partition_data, 0.1) && "Bisekcja spektralna poza dokladnoscia");
+    int cut = 0;
+    for (int i = 0; i + 1 < n; i++) {
+        cut += get_part_id(&graph, i) != get_part_id(&graph, i + 1);
+    }
+    assert(cut == 1 && "Sciezka powinna byc przecieta raz");
+    assert(partition_data.parts[0].part_vertex_count == n / 2 && "Nierowne polowy sciezki");
+    free_partition_data(&partition_data, 2);
+    free_graph(&graph);
+
+    // siatka 20 x 20 na 4 czesci
+    int side = 20;
+    int parts = 4;
+    n = side * side;
+    build_grid(&graph, side);
+    count_edges(&graph);
+    initialize_partition_data(&partition_data, parts);
+    assert(spectral_partition(&graph, parts, &partition_data, 0.1) && "Bisekcja spektralna poza dokladnoscia");
+    assert(check_all_parts_connected(&graph, parts, NULL) && "Czesci spektralne niespojne");
+    for (int p = 0; p < parts; p++) {
+        assert(partition_data.parts[p].part_vertex_count == n / parts && "Nierowne czesci siatki");
+    }
+
+    printf("Test bisekcji spektralnej: OK\n");
+    free_partition_data(&partition_data, parts);
+    free_graph(&graph);
+}
+
+// test bisekcji rekurencyjnej - sciezka na 3 czesci (cele wazone 1:2) i siatka na 6 czesci
+void test_recursive_bisection() {
+    Graph graph;
+    Partition_data partition_data;
+    int n = 99;
+
+    build_path(&graph, n);
+    count_edges(&graph);
+    assign_min_max_count(&graph, 3, 0.0);
+    initialize_partition_data(&partition_data, 3);
+    assert(recursive_bisection_partition(&graph, 3, &partition_data, 0.0) && "Bisekcja sciezki poza dokladnoscia");
+    int cut = 0;
+    for (int i = 0; i + 1 < n; i++) {
+        cut += get_part_id(&graph, i) != get_part_id(&graph, i + 1);
+    }
+    assert(cut == 2 && "Sciezka powinna byc przecieta dwa razy");
+    for (int p = 0; p < 3; p++) {
+        assert(partition_data.parts[p].part_vertex_count == n / 3 && "Nierowne czesci sciezki");
+    }
+    free_partition_data(&partition_data, 3);
+    free_graph(&graph);
+
+    int side = 30;
+    int parts = 6;
+    build_grid(&graph, side);
+    count_edges(&graph);
+    assign_min_max_count(&graph, parts, 0.1);
+    initialize_partition_data(&partition_data, parts);
+    assert(recursive_bisection_partition(&graph, parts, &partition_data, 0.1) && "Bisekcja siatki poza dokladnoscia");
+    assert(check_all_parts_connected(&graph, parts, NULL) && "Niespojna czesc po bisekcji");
+    for (int p = 0; p < parts; p++) {
+        int size = partition_data.parts[p].part_vertex_count;
+        assert(size >= graph.min_count && size <= graph.max_count && "Czesc poza dokladnoscia");
+    }
+    cut = 0;
+    for (int v = 0; v < graph.vertices; v++) {
+        for (int j = 0; j < graph.nodes[v].neighbor_count; j++) {
+            cut += get_part_id(&graph, v) != get_part_id(&graph, graph.nodes[v].neighbors[j]);
+        }
+    }
+    printf("Ciecie siatki %dx%d na %d czesci: %d\n", side, side, parts, cut / 2);
+    // pasy daja 150 przecietych krawedzi, uklad 2 x 3 okolo 90
+    assert(cut / 2 <= 150 && "Za duze ciecie bisekcji siatki");
+    printf("Test bisekcji rekurencyjnej: OK\n");
+    free_partition_data(&partition_data, parts);
+    free_graph(&graph);
+}
+
+// test rozwiazania dokladnego - siatka 6 x 6 na 3 czesci ma minimalne ciecie 10 (trzy pasy)
+void test_exact_partition() {
+    Graph graph;
+    Partition_data partition_data;
+    int side = 6;
+    int n = side * side;
+    int parts = 3;
+
+    build_grid(&graph, side);
+    count_edges(&graph);
+    initialize_partition_data(&partition_data, parts);
+
+    assert(exact_partition_suitable(&graph, parts) && "Siatka 6 x 6 na 3 czesci powinna byc dzielona dokladnie");
+    Exact_result result = exact_partition(&graph, parts, &partition_data, 0.1);
+    assert(result.status == 1 && result.cut == 10 && "Zle minimalne ciecie siatki");
+    assert(check_all_parts_connected(&graph, parts, NULL) && "Czesci dokladne niespojne");
+    for (int p = 0; p < parts; p++) {
+        assert(partition_data.parts[p].part_vertex_count == n / parts && "Nierowne czesci dokladne");
+    }
+    free_partition_data(&partition_data, parts);
+    free_graph(&graph);
+
+    // sciezka z przypietym koncem - czesc przypieta zostaje, ciecie nadal 1
+    n = 8;
+    build_path(&graph, n);
+    count_edges(&graph);
+    assing_parts(&graph, 2);
+    graph.pinned = malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        graph.pinned[i] = -1;
+    }
+    graph.pinned[0] = 1;
+    initialize_partition_data(&partition_data, 2);
+    result = exact_partition(&graph, 2, &partition_data, 0.1);
+    assert(result.status == 1 && result.cut == 1 && "Zle ciecie sciezki z przypieciem");
+    assert(get_part_id(&graph, 0) == 1 && get_part_id(&graph, n - 1) == 0 && "Przypiecie nie zostalo zachowane");
+    free_partition_data(&partition_data, 2);
+    free_graph(&graph);
+
+    // siatka 8 x 8 konczy sie szybko tylko dla 2 czesci
+    build_grid(&graph, 8);
+    assert(exact_partition_suitable(&graph, 2) && !exact_partition_suitable(&graph, 3) && "Zly prog podzialu dokladnego");
+    free_graph(&graph);
+
+    printf("Test rozwiazania dokladnego: OK\n");
+}
+
 int main() {
     printf("=== Testy Region Growing ===\n\n");
     
     test_small_region_growing();
     test_file_region_growing();
+    test_parallel_connectivity();
+    test_pinned_vertices();
+    test_adjacent_pinned_vertices();
+    test_many_parts();
+    test_parallel_region_growing();
+    test_farthest_seeds();
+    test_connectivity_repair();
+    test_geometric_partition();
+    test_spectral_partition();
+    test_exact_partition();
+    test_recursive_bisection();
     
     printf("\n=== Koniec testow region growing===\n");
     return 0;